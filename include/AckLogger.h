@@ -2,14 +2,14 @@
 #include "ReactiveObserver.h"
 #include "Acks.h"
 #include <iostream>
-#include <any>
+#include <variant>
 
 class AckLogger : public ReactiveObserver {
 public:
     void onEvent(const Event& ev) override {
         switch (ev.type) {
         case EventType::evSRPlanned: {
-            if (auto p = std::any_cast<ReactionPlannedAck>(&ev.payload)) {
+            if (auto p = std::get_if<ReactionPlannedAck>(&ev.payload)) {
                 std::cout << "[AckLogger] SRPLANNED corr=" << p->correlationId
                           << " res=" << p->resourceId
                           << " summary=" << p->summary << "\n";
@@ -17,7 +17,7 @@ public:
             break;
         }
         case EventType::evSRDone: {
-            if (auto d = std::any_cast<ReactionDoneAck>(&ev.payload)) {
+            if (auto d = std::get_if<ReactionDoneAck>(&ev.payload)) {
                 std::cout << "[AckLogger] SRDONE    corr=" << d->correlationId
                           << " rc=" << d->rc
                           << " summary=" << d->summary << "\n";
@@ -25,7 +25,7 @@ public:
             break;
         }
         case EventType::evMonActPlanned: {
-            if (auto p = std::any_cast<ReactionPlannedAck>(&ev.payload)) {
+            if (auto p = std::get_if<ReactionPlannedAck>(&ev.payload)) {
                 std::cout << "[AckLogger] MonActPLANNED corr=" << p->correlationId
                           << " res=" << p->resourceId
                           << " summary=" << p->summary << "\n";
@@ -33,7 +33,7 @@ public:
             break;
         }
         case EventType::evMonActDone: {
-            if (auto d = std::any_cast<ReactionDoneAck>(&ev.payload)) {
+            if (auto d = std::get_if<ReactionDoneAck>(&ev.payload)) {
                 std::cout << "[AckLogger] MonAct_DONE    corr=" << d->correlationId
                           << " rc=" << d->rc
                           << " summary=" << d->summary << "\n";
@@ -41,7 +41,7 @@ public:
             break;
         }
         case EventType::evProcessFail:{}
-             if (auto d = std::any_cast<ProcessFailAck>(&ev.payload)) {
+             if (auto d = std::get_if<ProcessFailAck>(&ev.payload)) {
                 std::cout << "[AckLogger] ProcessFail    corr=" << d->correlationId
                           << " processName=" << d->processName
                           << " summary=" << d->summary << "\n";
@@ -49,7 +49,7 @@ public:
             break;
 
         case EventType::evIngestionPlanned: {
-            if (auto p = std::any_cast<IngestionPlannedAck>(&ev.payload)) {
+            if (auto p = std::get_if<IngestionPlannedAck>(&ev.payload)) {
                 std::cout << "[AckLogger] INGESTION PLANNED corr=" << p->correlationId
                         << " indiv=" << p->individualName
                         << " process=" << p->process
@@ -58,7 +58,7 @@ public:
             break;
         }
         case EventType::evIngestionDone: {
-            if (auto d = std::any_cast<IngestionDoneAck>(&ev.payload)) {
+            if (auto d = std::get_if<IngestionDoneAck>(&ev.payload)) {
                 std::cout << "[AckLogger] INGESTION DONE    corr=" << d->correlationId
                         << " rc=" << d->rc
                         << " msg=" << d->message << "\n";
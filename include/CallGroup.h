@@ -0,0 +1,35 @@
+// CallGroup.h – CallMethod-Schritte eines Plans gruppenweise ausführen
+//
+// Die CallMethod-Schritte einer Schrittgruppe (stepGroupEnd in Plan.h: gleiche group oder
+// aufeinanderfolgende Operation::independent) gehen als EIN UA_CallRequest an die SPS
+// (PLCMonitor::callMethodsTyped), ein einzelner CallMethod-Schritt per callMethodTyped. Genutzt von MonitoringActionForce und SystemReactionForce;
+// der Soll/Ist-Vergleich der Outputs bleibt beim Aufrufer.
+#pragma once
+#include <functional>
+#include <vector>
+#include "Plan.h"
+#include "common_types.h"
+
+class PLCMonitor;
+
+struct CallStepResult {
+    bool       callOk = false;   // Aufruf mit Status Good beantwortet
+    UAValueMap got;              // tatsächliche Outputs (index -> Wert)
+};
+
+// Führt die CallMethod-Schritte in ops[b..e) aus; Ergebnis[k] gehört zu ops[b+k] (andere
+// OpTypes bleiben unberührt: callOk = false, got leer).
+// Timeout einer Gruppe = größter Schritt-Timeout (0 -> defaultTimeoutMs).
+std::vector<CallStepResult> executeCallGroup(PLCMonitor& mon,
+                                             const std::vector<Operation>& ops,
+                                             size_t b, size_t e,
+                                             unsigned defaultTimeoutMs);
+
+// Wie executeCallGroup, aber ohne zu blockieren (PLCMonitor::callMethodsAsync): kehrt sofort
+// zurück, done(results) läuft im UA-Thread – auch bei Timeout/Disconnect (callOk = false).
+// Ohne CallMethod-Schritt in [b, e) kommt done sofort im Aufrufer.
+void executeCallGroupAsync(PLCMonitor& mon,
+                           const std::vector<Operation>& ops,
+                           size_t b, size_t e,
+                           unsigned defaultTimeoutMs,
+                           std::function<void(std::vector<CallStepResult>)> done);
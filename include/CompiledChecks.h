@@ -0,0 +1,122 @@
+// Vorkompilierte Erwartungs-Checks der Failure-Mode-Kandidaten.
+// - Die KgExpect-Listen aller Kandidaten eines Skills werden einmal gegen die NodeTable
+//   eines Inventarstands aufgelöst: je Datentyp flache Arrays (Slot, Sollwert), pro
+//   Kandidat ein Offset-Bereich in jedem Array.
+// - passes()/evaluate() prüfen danach nur noch Spalten des InventorySnapshot: keine
+//   Hash-Lookups, kein switch je Erwartung, keine Report-Strings. Die Schleifen sind
+//   branchfrei (Fehler werden per OR akkumuliert), damit der Compiler sie vektorisieren
+//   kann; zwischen den Typ-Blöcken wird je Kandidat früh abgebrochen.
+// - Gültig nur für Snapshots mit derselben NodeTable (matches()); sonst neu kompilieren.
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InventorySnapshot.h"
+
+class CompiledChecks {
+public:
+    CompiledChecks() = default;
+    explicit CompiledChecks(NodeTablePtr nodes) : nodes_(std::move(nodes)) {}
+
+    // ---- Aufbau: beginCandidate(), dann expectXxx(...) für dessen Erwartungen ----
+    void beginCandidate() {
+        offBool_.push_back(static_cast<uint32_t>(boolSlot_.size()));
+        offI16_.push_back(static_cast<uint32_t>(i16Slot_.size()));
+        offF64_.push_back(static_cast<uint32_t>(f64Slot_.size()));
+        offStr_.push_back(static_cast<uint32_t>(strSlot_.size()));
+        dead_.push_back(0);
+    }
+    // Aktuellen Kandidaten verwerfen (z. B. fehlerhafter Params-Block): passes() immer false
+    void markDead() { if (!dead_.empty()) dead_.back() = 1; }
+    void expectBool(const NodeKey& k, bool v) {
+        if (const uint32_t s = resolve_(k); s != NodeTable::kNoSlot) {
+            boolSlot_.push_back(s); boolExp_.push_back(v ? 1 : 0);
+        }
+    }
+    void expectInt16(const NodeKey& k, int16_t v) {
+        if (const uint32_t s = resolve_(k); s != NodeTable::kNoSlot) {
+            i16Slot_.push_back(s); i16Exp_.push_back(v);
+        }
+    }
+    void expectFloat(const NodeKey& k, double v) {
+        if (const uint32_t s = resolve_(k); s != NodeTable::kNoSlot) {
+            f64Slot_.push_back(s); f64Exp_.push_back(v);
+        }
+    }
+    void expectString(const NodeKey& k, std::string v) {
+        if (const uint32_t s = resolve_(k); s != NodeTable::kNoSlot) {
+            strSlot_.push_back(s); strExp_.push_back(std::move(v));
+        }
+    }
+
+    size_t candidates() const { return dead_.size(); }
+    bool matches(const InventorySnapshot& inv) const { return nodes_ && inv.nodes == nodes_; }
+
+    // true, wenn alle Erwartungen von Kandidat c im Snapshot erfüllt sind.
+    // Typ-Tag != None impliziert Gültigkeit (InventorySnapshot::mark setzt beides),
+    // daher genügt der Vergleich mit kind[] statt Bitmap + Tag.
+    bool passes(const InventorySnapshot& inv, size_t c) const {
+        if (dead_[c]) return false;
+        const VarKind* kind = inv.kind.data();
+
+        uint32_t bad = 0;
+        {
+            const uint8_t* col = inv.colBool.data();
+            for (uint32_t i = offBool_[c], e = end_(offBool_, boolSlot_, c); i < e; ++i) {
+                const uint32_t s = boolSlot_[i];
+                bad |= static_cast<uint32_t>(kind[s] != VarKind::Bool) | static_cast<uint32_t>(col[s] != boolExp_[i]);
+            }
+        }
+        if (bad) return false;
+        {
+            const int16_t* col = inv.colI16.data();
+            for (uint32_t i = offI16_[c], e = end_(offI16_, i16Slot_, c); i < e; ++i) {
+                const uint32_t s = i16Slot_[i];
+                bad |= static_cast<uint32_t>(kind[s] != VarKind::Int16) | static_cast<uint32_t>(col[s] != i16Exp_[i]);
+            }
+        }
+        if (bad) return false;
+        {
+            const double* col = inv.colF64.data();
+            for (uint32_t i = offF64_[c], e = end_(offF64_, f64Slot_, c); i < e; ++i) {
+                const uint32_t s = f64Slot_[i];
+                bad |= static_cast<uint32_t>(kind[s] != VarKind::Float) | static_cast<uint32_t>(col[s] != f64Exp_[i]);
+            }
+        }
+        if (bad) return false;
+        // Strings zuletzt (teuerster Vergleich), mit Abbruch beim ersten Unterschied
+        for (uint32_t i = offStr_[c], e = end_(offStr_, strSlot_, c); i < e; ++i) {
+            const uint32_t s = strSlot_[i];
+            if (kind[s] != VarKind::String || inv.colStr[s] != strExp_[i]) return false;
+        }
+        return true;
+    }
+
+    // Alle Kandidaten auf einmal: ok[c] = passes(inv, c)
+    void evaluate(const InventorySnapshot& inv, std::vector<uint8_t>& ok) const {
+        ok.assign(candidates(), 0);
+        for (size_t c = 0; c < ok.size(); ++c) ok[c] = passes(inv, c) ? 1 : 0;
+    }
+
+private:
+    // Schlüssel ohne Slot kann nie im Cache stehen -> Kandidat schlägt sicher fehl
+    uint32_t resolve_(const NodeKey& k) {
+        const uint32_t s = nodes_ ? nodes_->find(k) : NodeTable::kNoSlot;
+        if (s == NodeTable::kNoSlot && !dead_.empty()) dead_.back() = 1;
+        return s;
+    }
+    // Ende des Bereichs von Kandidat c (letzter Kandidat reicht bis Array-Ende)
+    template <class V>
+    static uint32_t end_(const std::vector<uint32_t>& off, const V& arr, size_t c) {
+        return c + 1 < off.size() ? off[c + 1] : static_cast<uint32_t>(arr.size());
+    }
+
+    NodeTablePtr nodes_;
+    std::vector<uint8_t>     dead_;                      // je Kandidat: unauflösbarer Schlüssel
+    std::vector<uint32_t>    offBool_, offI16_, offF64_, offStr_;   // je Kandidat: Start-Offset
+    std::vector<uint32_t>    boolSlot_, i16Slot_, f64Slot_, strSlot_;
+    std::vector<uint8_t>     boolExp_;
+    std::vector<int16_t>     i16Exp_;
+    std::vector<double>      f64Exp_;
+    std::vector<std::string> strExp_;
+};
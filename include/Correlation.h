@@ -1,7 +1,11 @@
 // File: Correlation.h
-// Zweck: Erzeugt eindeutige Correlation-IDs für Tracing über Teilkomponenten.
-//        Format: "<prefix>-<nanoseconds>-<counter>".
-// 
+// Zweck: Eindeutige Correlation-IDs für Tracing über Teilkomponenten.
+//        CorrelationId ist 128 Bit groß und trivial kopierbar: Quelle (evD1/evD2/evD3 …),
+//        globaler Zähler und steady_clock-Zeitstempel. Als Map-Key (CorrelationIdHash)
+//        und in Acks/Events wird nur die Struktur kopiert; Text im Format
+//        "<prefix>-<nanoseconds>-<counter>" entsteht erst bei Bedarf (Logs, KG-Ingestion)
+//        über str() bzw. operator<<.
+//
 // In der MPA wird diese ID u. a. genutzt, um:
 //  - D1/D2/D3-Snapshots,
 //  - KG-Requests/-Responses,
@@ -10,15 +14,73 @@
 // eindeutig zu korrelieren.
 #pragma once
 #include <atomic>
-#include <string>
 #include <chrono>
-// Erzeugt eine neue, global eindeutige Correlation-Id mit einem beliebigen Prefix.
-// Thread-sicher durch atomaren Zähler + Monotone Uhr.
-inline std::string makeCorrelationId(const char* prefix) {
-    static std::atomic<unsigned long long> ctr{1}; // atomarer Zähler für Eindeutigkeit
-    const auto n  = ctr.fetch_add(1);
-    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                        std::chrono::steady_clock::now().time_since_epoch()).count();
-    // Zusammenbau der ID (ohne Allokationen optimiert wäre möglich, aber hier genügt std::string)
-    return std::string(prefix) + "-" + std::to_string(ns) + "-" + std::to_string(n);
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+// Erzeuger der Id; bestimmt nur den Text-Prefix
+enum class CorrSource : std::uint16_t { None = 0, D1, D2, D3, Other };
+
+inline const char* corrPrefix(CorrSource s) {
+    switch (s) {
+        case CorrSource::D1:    return "evD1";
+        case CorrSource::D2:    return "evD2";
+        case CorrSource::D3:    return "evD3";
+        case CorrSource::Other: return "corr";
+        default:                return "ev";
+    }
+}
+
+struct CorrelationId {
+    std::uint64_t ns  = 0;                  // steady_clock bei Erzeugung (Nanosekunden)
+    std::uint32_t seq = 0;                  // globaler, monotoner Zähler; 0 = keine Id
+    CorrSource    src = CorrSource::None;
+    std::uint16_t reserved = 0;
+
+    bool valid() const { return seq != 0; }
+    bool operator==(const CorrelationId& o) const { return seq == o.seq && ns == o.ns && src == o.src; }
+    bool operator!=(const CorrelationId& o) const { return !(*this == o); }
+
+    // Textform für Logs/Ingestion, z. B. "evD2-81234567890123-42"; leer ohne Id (seq == 0)
+    std::string str() const {
+        if (!valid()) return {};
+        char buf[64];
+        const int n = std::snprintf(buf, sizeof(buf), "%s-%llu-%u", corrPrefix(src),
+                                    static_cast<unsigned long long>(ns), static_cast<unsigned>(seq));
+        return std::string(buf, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+};
+static_assert(sizeof(CorrelationId) == 16 && std::is_trivially_copyable_v<CorrelationId>,
+              "CorrelationId soll 128 Bit und trivial kopierbar bleiben");
+
+inline std::ostream& operator<<(std::ostream& os, const CorrelationId& c) {
+    if (!c.valid()) return os;
+    return os << corrPrefix(c.src) << '-' << c.ns << '-' << c.seq;
+}
+
+// seq ist bereits eindeutig; der splitmix64-Finalizer verteilt die fortlaufenden Werte
+struct CorrelationIdHash {
+    size_t operator()(const CorrelationId& c) const noexcept {
+        std::uint64_t x = (static_cast<std::uint64_t>(c.seq) << 16) ^ static_cast<std::uint64_t>(c.src) ^ c.ns;
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return static_cast<size_t>(x);
+    }
+};
+
+// Erzeugt eine neue, global eindeutige Correlation-Id.
+// Thread-sicher durch atomaren Zähler + monotone Uhr.
+inline CorrelationId makeCorrelationId(CorrSource src) {
+    static std::atomic<std::uint32_t> ctr{1};   // atomarer Zähler für Eindeutigkeit
+    CorrelationId id;
+    id.seq = ctr.fetch_add(1, std::memory_order_relaxed);
+    if (id.seq == 0) id.seq = ctr.fetch_add(1, std::memory_order_relaxed);   // Überlauf: 0 ist reserviert
+    id.ns  = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch()).count());
+    id.src = src;
+    return id;
 }
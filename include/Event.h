@@ -2,13 +2,20 @@
 //
 // EventType      : alle im Framework verwendeten Event-Typen (siehe MPA_Draft),
 //                  z. B. D-Events, KG-Resultate, Monitoring-/System-Reaktions-Acks.
-// Event          : konkretes Event mit Zeitstempel und typisierbarer Payload (std::any).
+// Event          : konkretes Event mit Zeitstempel, typisierter Payload (std::variant über
+//                  die Structs aus Acks.h/Event.h) und correlationId als eigenem Feld.
 // KGResultPayload/KGTimeoutPayload/PLCSnapshotPayload:
 //                  Convenience-Strukturen für häufige Event-Payloads.
 #pragma once
-#include <any>
+#include <cstddef>
 #include <chrono>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include "Acks.h"
+#include "Correlation.h"
+#include "InventorySnapshot.h"   // D2Snapshot
 
 // Liste aller Events, die über EventBus gepostet/abonniert werden können.
 // Diese Enum-Werte werden in Acks.h und den Observern (ReactionManager, FailureRecorder, …)
@@ -22,28 +29,58 @@ enum class EventType {
     evMonActFinished, evSysReactFinished,
     evUnknownFM, evGotFM
 };
-// Minimale Event-Hülle: Typ, Zeitstempel, generische Payload.
-// Die Payload wird per std::any auf eine konkrete Struktur aus Acks.h gecastet.
-struct Event {
-    EventType type{};
-    std::chrono::steady_clock::time_point ts{ std::chrono::steady_clock::now() };
-    std::any payload; // typisierte Payloads (siehe Acks.h)
-};
+// Anzahl der EventTypes (dichte Tabellen im EventBus); bei neuen Typen den letzten Wert anpassen.
+inline constexpr size_t kEventTypeCount = static_cast<size_t>(EventType::evGotFM) + 1;
 // Payload, wenn die KG-Abfrage ein rowsJson (z. B. Monitoring-/SystemReaction-Payload)
 // zurückliefert. Kann in PlanJsonUtils weiterverarbeitet werden.
 struct KGResultPayload {
-    std::string correlationId;
+    CorrelationId correlationId;
     std::string rowsJson;
     bool ok;
 };
 
 // Payload, wenn eine KG-Anfrage (z. B. via PythonWorker) in einen Timeout läuft.
 struct KGTimeoutPayload {
-    std::string correlationId;
+    CorrelationId correlationId;
 };
 // Snapshot-Payload direkt als JSON (Alternative zu InventorySnapshot), z. B. für
 // einfache Prototyping-Pfade oder Logging.
 struct PLCSnapshotPayload {
-    std::string correlationId;   // vom Erzeuger vergeben (z. B. "evD2-...")
+    CorrelationId correlationId; // vom Erzeuger vergeben (makeCorrelationId)
     std::string snapshotJson;    // z.B. {"rows":[...],"vals":{...},"processName":"..."}
-};
\ No newline at end of file
+};
+
+// Alle Payload-Typen, die über den EventBus laufen. Inline im Event gespeichert (keine
+// Heap-Allokation wie bei std::any); Zugriff per std::get_if<T>(&ev.payload).
+// Jeder Typ (außer monostate) trägt ein Feld correlationId.
+using EventPayload = std::variant<
+    std::monostate,
+    D2Snapshot,
+    ReactionPlannedAck, ReactionDoneAck, ProcessFailAck,
+    IngestionPlannedAck, IngestionDoneAck,
+    MonActFinishedAck, SysReactFinishedAck,
+    UnknownFMAck, GotFMAck,
+    KGResultAck, KGTimeoutAck, DStateAck,
+    KGResultPayload, KGTimeoutPayload, PLCSnapshotPayload>;
+
+inline CorrelationId correlationIdOf(const EventPayload& p) {
+    return std::visit([](const auto& v) -> CorrelationId {
+        if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::monostate>) return {};
+        else return v.correlationId;
+    }, p);
+}
+
+// Event-Hülle: Typ, Zeitstempel, typisierte Payload. Die correlationId wird beim Erzeugen
+// einmal aus der Payload übernommen, Observer brauchen dafür keine Cast-Ketten mehr.
+struct Event {
+    using Clock = std::chrono::steady_clock;
+
+    EventType         type{};
+    Clock::time_point ts{ Clock::now() };
+    EventPayload      payload;          // typisierte Payloads (siehe Acks.h)
+    CorrelationId     correlationId;    // !valid() bei Events ohne Payload
+
+    Event() = default;
+    Event(EventType t, Clock::time_point at = Clock::now(), EventPayload p = {})
+        : type(t), ts(at), payload(std::move(p)), correlationId(correlationIdOf(payload)) {}
+};
@@ -1,19 +1,15 @@
 #pragma once
 #include "Event.h"
 #include "ReactiveObserver.h"
-#include <unordered_map>
+#include <array>
 #include <vector>
 #include <deque>
 #include <mutex>
 #include <memory>
 #include <atomic>
 #include <cstdint>
-
-struct EventTypeHash {
-    size_t operator()(EventType t) const noexcept {
-        return static_cast<size_t>(t);
-    }
-};
+#include <functional>
+#include <thread>
 
 // Eindeutiger Schlüssel für eine Subscription:
 struct SubscriptionToken {
@@ -51,7 +47,13 @@ private:
 
 class EventBus {
 public:
-    EventBus() = default;
+    static constexpr size_t kDefaultRingCapacity = 1024;
+
+    // ringCapacity wird auf die nächste Zweierpotenz aufgerundet
+    explicit EventBus(size_t ringCapacity = kDefaultRingCapacity);
+    ~EventBus();
+    EventBus(const EventBus&)            = delete;
+    EventBus& operator=(const EventBus&) = delete;
 
     // Prioritätenbereich: 1..4 (Konvention: 4 z. B. TaskManager)
     static constexpr int kMinPriority = 1;
@@ -72,15 +74,31 @@ public:
     // Manuelles Abbestellen
     void unsubscribe(const SubscriptionToken& tok);
 
-    // Ereignisse einreihen (thread-sicher, asynchron)
+    // Ereignisse einreihen (thread-sicher, asynchron, lock-frei über den Ring;
+    // nur bei vollem Ring landet das Event in einer Mutex-geschützten Überlauf-Queue)
     void post(Event ev);
 
     // Sofort verteilen (synchron; vorsichtig bzgl. Reentranz)
     void post_now(const Event& ev);
 
-    // Warteschlange bearbeiten; maxEvents = Schutz gegen Starvation
+    // Warteschlange bearbeiten; maxEvents = Schutz gegen Starvation.
+    // No-op, solange der Dispatch-Thread läuft (der verteilt dann selbst).
     void process(size_t maxEvents = 32);
 
+    // Dedizierter Dispatch-Thread: schläft bei leerer Queue und wird von post() geweckt,
+    // Events gehen damit ohne Main-Loop-Takt an die Observer (Reihenfolge = FIFO).
+    // Observer laufen dann auf diesem Thread, nicht mehr im Main-Loop.
+    bool startDispatchThread();
+    void stopDispatchThread();      // restliche Events werden noch verteilt
+    bool dispatchThreadActive() const { return dispatching_.load(std::memory_order_acquire); }
+
+    // Weckruf für einen externen Main-Loop (z. B. PLCMonitor::wakeup), der process()
+    // aufruft: post() ruft ihn auf, solange kein Dispatch-Thread läuft. Vor dem ersten
+    // post() setzen.
+    void setWakeHook(std::function<void()> fn) { wakeHook_ = std::move(fn); }
+    // true, wenn noch Events auf process() warten
+    bool hasPending() const { return has_pending(); }
+
     // Queue leeren (optional)
     void clear_queue();
 
@@ -90,14 +108,54 @@ private:
         std::uint64_t id{0};     // Anmelde-Reihenfolge (kleiner = älter)
         int priority{kMinPriority};
     };
+    // Unveränderliche, bereits sortierte Listener-Liste je EventType (RCU): Schreiber
+    // kopieren unter mx_, fügen sortiert ein und tauschen den shared_ptr; dispatch_one()
+    // lädt nur den Zeiger und läuft linear durch.
+    using ListenerList = std::vector<Entry>;
+    using ListenerPtr  = std::shared_ptr<const ListenerList>;
+
+    // Begrenzter Ring (Vyukov): jede Zelle trägt eine Sequenznummer, Producer reservieren
+    // per CAS auf enqPos_, der Konsument gibt die Zelle über seq wieder frei.
+    struct Cell {
+        std::atomic<size_t> seq{0};
+        Event ev;
+    };
+
+    bool ring_push(Event& ev);      // verschiebt ev nur bei Erfolg
+    bool ring_pop(Event& out);
+    bool ring_empty() const;
+    bool pop_next(Event& out);      // Ring zuerst, dann Überlauf
+    bool has_pending() const;
+    void wake_dispatcher();
+    void dispatch_loop(std::stop_token st);
 
     void dispatch_one(const Event& ev);
     void sweep_dead(EventType t); // tote weak_ptrs wegräumen
 
-    std::mutex mx_;
-    std::deque<Event> q_;
-    std::unordered_map<EventType, std::vector<Entry>, EventTypeHash> listeners_;
+    static size_t slot(EventType t) { return static_cast<size_t>(t); }
+    ListenerPtr listeners(EventType t) const {
+        return listeners_[slot(t)].load(std::memory_order_acquire);
+    }
+
+    std::mutex mx_;                 // serialisiert nur Schreiber der Listener-Tabelle
+    std::array<std::atomic<ListenerPtr>, kEventTypeCount> listeners_{};
     std::atomic<std::uint64_t> nextId_{1};
 
+    std::unique_ptr<Cell[]> ring_;
+    size_t                  mask_{0};
+    alignas(64) std::atomic<size_t> enqPos_{0};
+    alignas(64) std::atomic<size_t> deqPos_{0};
+
+    std::mutex                 ovmx_;          // Überlauf bei vollem Ring
+    std::deque<Event>          overflow_;
+    std::atomic<size_t>        overflowCount_{0};
+
+    // Wake-on-post: Dispatcher setzt sleeping_ und wartet auf wake_ (atomic wait/notify)
+    std::atomic<bool>          sleeping_{false};
+    std::atomic<std::uint32_t> wake_{0};
+    std::atomic<bool>          dispatching_{false};
+    std::function<void()>      wakeHook_;
+    std::jthread               dispatcher_;
+
     friend class Subscription;
 };
@@ -12,6 +12,7 @@
 #include "EventBus.h"
 #include "Event.h"
 #include "Plan.h"
+#include "Correlation.h"          // CorrelationId / CorrelationIdHash (Map-Keys)
 #include "InventorySnapshot.h"    // InventorySnapshot / D2Snapshot
 #include "KGIngestionParams.h"    // KgIngestionParams (siehe oben)
 
@@ -24,30 +25,27 @@ public:
     void onEvent(const Event& ev) override;
 
 private:
-    void resetCorrUnlocked(const std::string& corr);
-    std::unordered_set<std::string> activeCorr_;
+    void resetCorrUnlocked(CorrelationId corr);
+    std::unordered_set<CorrelationId, CorrelationIdHash> activeCorr_;
     using json = nlohmann::json;
 
     EventBus& bus_;
 
     // Recorder-interner Cache je correlationId:
     std::mutex mx_;
-    std::unordered_map<std::string, std::string>               snapshotJsonByCorr_;
-    std::unordered_map<std::string, std::vector<std::string>>  monReactsByCorr_;
-    std::unordered_map<std::string, std::vector<std::string>>  sysReactsByCorr_;
-    std::unordered_set<std::string>                             ingestionStarted_;
-    std::unordered_map<std::string, std::string> failureModeByCorr_;
+    std::unordered_map<CorrelationId, InventorySnapshotPtr, CorrelationIdHash>      snapshotByCorr_;   // nativ, JSON erst bei Ingestion
+    std::unordered_map<CorrelationId, std::vector<std::string>, CorrelationIdHash>  monReactsByCorr_;
+    std::unordered_map<CorrelationId, std::vector<std::string>, CorrelationIdHash>  sysReactsByCorr_;
+    std::unordered_set<CorrelationId, CorrelationIdHash>                            ingestionStarted_;
+    std::unordered_map<CorrelationId, std::string, CorrelationIdHash> failureModeByCorr_;
     // optional: FailureModesByCorr_ kannst du später genauso hinzufügen
-    bool tryMarkIngestion(const std::string& corr);
+    bool tryMarkIngestion(CorrelationId corr);
     // Helpers
     static json        snapshotToJson(const InventorySnapshot& inv); // (legacy) unbenutzt hier
     static std::string now_ts();
-    static std::string wrapSnapshot(const std::string& js);
-    static std::string findStringInSnap(const json& snap, const char* nodeId);
-    static json        snapshotToJson_flat(const InventorySnapshot& inv);
 
     std::shared_ptr<KgIngestionParams>
-    buildParams(const std::string& corr, const std::string& process, const std::string& summary);
+    buildParams(CorrelationId corr, const std::string& process, const std::string& summary);
 
     void startIngestionWith(std::shared_ptr<KgIngestionParams> prm);
 };
@@ -8,11 +8,18 @@
 //
 // Die Factory (CommandForceFactory) liefert zur passenden Operation eine
 // ICommandForce-Instanz, die execute(const Plan&) synchron ausführt.
+// executeAsync(...) ist die Variante ohne blockierende Wartezeiten: done(rc) wird
+// aufgerufen, sobald der Plan durchgelaufen ist (ggf. aus einem anderen Thread).
 #pragma once
+#include <functional>
 #include "Plan.h"
 
 struct ICommandForce {
+    using Done = std::function<void(int rc)>;
+
     virtual ~ICommandForce() = default;
     // synchroner Ablauf; Rückgabe 1 = OK, 0 = Fehler
     virtual int execute(const Plan& p) = 0;
+    // Default: synchron ausführen und sofort melden
+    virtual void executeAsync(const Plan& p, Done done) { done(execute(p)); }
 };
\ No newline at end of file
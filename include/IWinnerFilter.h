@@ -4,16 +4,22 @@
 //  - IWinnerFilter nimmt diese „theoretischen Gewinner“ entgegen und führt
 //    domänenspezifische Prüfungen aus (MonitoringActions / SystemReactions).
 //  - Das Ergebnis ist eine gefilterte Liste von IRIs, die die Prüfungen bestanden haben.
+//  - filterAsync(...) liefert es per Callback, ohne den Aufrufer zu blockieren (Default:
+//    synchron über filter(...)).
 //
 // Konkrete Implementierungen:
 //  - MonitoringActionForce : ruft Monitoring-Skills auf und prüft deren Outputs.
 //  - SystemReactionForce   : führt System-Reaktionen aus und prüft Feedback.
 #pragma once
+#include <functional>
 #include <vector>
 #include <string>
+#include "Correlation.h"
 
 
 struct IWinnerFilter {
+    using Done = std::function<void(std::vector<std::string> kept)>;
+
     virtual ~IWinnerFilter() = default;
 
     // winners          : Kandidaten-FailureModes (IRIs) aus der KG-Suche.
@@ -23,6 +29,17 @@ struct IWinnerFilter {
     // Rückgabe: Teilmenge von winners, deren Monitoring-/Systemreaktionschecks erfolgreich waren.
     virtual std::vector<std::string>
     filter(const std::vector<std::string>& winners,
-           const std::string& correlationId,
+           CorrelationId correlationId,
            const std::string& processNameForAck) = 0;
+
+    // Wie filter(...); done(kept) kommt, sobald alle Prüfungen durch sind (ggf. aus einem
+    // anderen Thread). Die Instanz darf vorher zerstört werden, sofern die Implementierung
+    // das zusagt (SystemReactionForce).
+    virtual void filterAsync(const std::vector<std::string>& winners,
+                             CorrelationId correlationId,
+                             const std::string& processNameForAck,
+                             Done done)
+    {
+        done(filter(winners, correlationId, processNameForAck));
+    }
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+// InventoryRow.h – eine Zeile des PLC-Inventars (Browse-Ergebnis)
+//
+// Eigener Header, damit InventorySnapshot (und damit Event-Payloads) ohne open62541
+// auskommen; PLCMonitor::InventoryRow ist ein Alias darauf.
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+struct InventoryRow {
+    std::string nodeClass;   // "Variable", "Method", "Object"
+    std::string nodeId;      // "ns=4;s=OPCUA.DiagnoseFinished", ...
+    std::string dtypeOrSig;  // z. B. "Boolean" oder "in: [Int32], out: [Int32]"
+};
+
+// Inventar eines Stands: vom Inventory-Cache einmal erzeugt, danach nur geteilt (nie kopiert)
+using InventoryRows    = std::vector<InventoryRow>;
+using InventoryRowsPtr = std::shared_ptr<const InventoryRows>;
@@ -1,7 +1,10 @@
 // Repräsentiert einen typisierten Snapshot des OPC-UA-Adressraums der SPS.
 // - NodeKey:      Schlüssel (Namespace, Typ, String-ID) für Variablenknoten.
+// - NodeTable:    Interning NodeKey -> dichter Slot (uint32_t), einmal je Inventarstand
+//                 aufgebaut und von allen Snapshots dieses Stands geteilt.
 // - InventorySnapshot.rows  : reine Strukturinformationen (NodeClass, NodeId, Datentyp).
-// - InventorySnapshot.bools/strings/int16s/floats:
+// - InventorySnapshot-Spalten (struct-of-arrays, Index = Slot):
+//                   Typ-Tag, Gültigkeits-Bitmap und je Datentyp eine Wertespalte,
 //                   aktuell gelesene Werte der Variablen an einer Stelle in der Zeit.
 // - D2Snapshot:   Event-Payload (correlationId + Snapshot), wie von D2/D3 erzeugt
 //                 und im ReactionManager/FailureRecorder verwendet.
@@ -9,8 +12,12 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include "PLCMonitor.h"  // für PLCMonitor::InventoryRow
-// Schlüssel zur Identifikation eines Knotens (für die Werte-Maps im Snapshot).
+#include <cstdint>
+#include <memory>
+#include <functional>
+#include "InventoryRow.h"  // (= PLCMonitor::InventoryRow), ohne open62541
+#include "Correlation.h"    // CorrelationId (D2Snapshot)
+// Schlüssel zur Identifikation eines Knotens.
 struct NodeKey {
     uint16_t    ns   = 4;
     char        type = 's';     // 's'|'i'|'g'|'b'
@@ -19,29 +26,126 @@ struct NodeKey {
         return ns == o.ns && type == o.type && id == o.id;
     }
 };
-// Hash-Funktor für NodeKey, damit er als Schlüssel in unordered_map verwendbar ist.
+// Hash-Funktor für NodeKey. ns/type werden per hash_combine eingemischt (statt XOR mit
+// Shift), damit ähnliche "OPCUA.*"-Namen in verschiedenen Namespaces nicht kollidieren.
 struct NodeKeyHash {
     size_t operator()(const NodeKey& k) const noexcept {
-        return std::hash<uint16_t>{}(k.ns)
-             ^ (std::hash<char>{}(k.type) << 1)
-             ^ (std::hash<std::string>{}(k.id) << 2);
+        size_t h = std::hash<std::string>{}(k.id);
+        const size_t tag = (static_cast<size_t>(k.ns) << 8) | static_cast<unsigned char>(k.type);
+        h ^= tag + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h;
     }
 };
 
-// Ex RM: typisierter Snapshot
+// Interning-Tabelle: jeder inventarisierte Variablenknoten bekommt einen dichten Slot.
+// Wird beim Snapshot-Aufbau einmal je Inventarstand erzeugt und danach nur gelesen.
+struct NodeTable {
+    static constexpr uint32_t kNoSlot = 0xFFFFFFFFu;
+
+    std::vector<NodeKey> keys;              // Slot -> NodeKey
+
+    uint32_t intern(const NodeKey& k) {
+        auto [it, inserted] = index_.try_emplace(k, static_cast<uint32_t>(keys.size()));
+        if (inserted) keys.push_back(k);
+        return it->second;
+    }
+    uint32_t find(const NodeKey& k) const {
+        auto it = index_.find(k);
+        return it == index_.end() ? kNoSlot : it->second;
+    }
+    size_t size() const { return keys.size(); }
+
+private:
+    std::unordered_map<NodeKey, uint32_t, NodeKeyHash> index_;
+};
+using NodeTablePtr = std::shared_ptr<const NodeTable>;
+
+// Datentyp eines Slots im Snapshot (Typ-Tag-Spalte).
+enum class VarKind : uint8_t { None = 0, Bool, Int16, Float, String };
+
+// Ex RM: typisierter Snapshot, spaltenweise
 // rows   : reine Struktur (Namensraum, NodeClass, Typ, …)
-// bools, strings, int16s, floats : aktuelle Werte zu den NodeKeys.
+// nodes  : Slot-Tabelle; kind/valid/colXxx haben je nodes->size() Einträge.
+// Float enthält Double- und Float-Variablen (als double).
 struct InventorySnapshot {
-    std::vector<PLCMonitor::InventoryRow> rows;
-    std::unordered_map<NodeKey, bool,        NodeKeyHash> bools;
-    std::unordered_map<NodeKey, std::string, NodeKeyHash> strings;
-    std::unordered_map<NodeKey, int16_t,     NodeKeyHash> int16s;
-    std::unordered_map<NodeKey, double,      NodeKeyHash> floats;
+    InventoryRowsPtr          rows;       // geteilt mit dem Inventory-Cache des PLCMonitor
+    NodeTablePtr              nodes;
+    std::vector<VarKind>      kind;       // Typ-Tag je Slot
+    std::vector<uint64_t>     valid;      // Bit je Slot: Wert vorhanden
+    std::vector<uint8_t>      colBool;
+    std::vector<int16_t>      colI16;
+    std::vector<double>       colF64;
+    std::vector<std::string>  colStr;
+
+    // Spalten für die Slots von t dimensionieren (alle ungültig).
+    void reset(NodeTablePtr t) {
+        nodes = std::move(t);
+        const size_t n = nodes ? nodes->size() : 0;
+        kind.assign(n, VarKind::None);
+        valid.assign((n + 63) / 64, 0);
+        colBool.assign(n, 0);
+        colI16.assign(n, 0);
+        colF64.assign(n, 0.0);
+        colStr.assign(n, std::string{});
+    }
+
+    // Strukturzeilen (leer ohne Inventar)
+    const InventoryRows& rowList() const {
+        static const InventoryRows kEmpty;
+        return rows ? *rows : kEmpty;
+    }
+
+    size_t slots() const { return kind.size(); }
+    uint32_t slotOf(const NodeKey& k) const { return nodes ? nodes->find(k) : NodeTable::kNoSlot; }
+    const NodeKey& key(uint32_t slot) const { return nodes->keys[slot]; }
+    bool has(uint32_t slot) const {
+        return slot < kind.size() && (valid[slot >> 6] >> (slot & 63)) & 1u;
+    }
+    // true, wenn slot einen Wert vom Typ k trägt
+    bool has(uint32_t slot, VarKind k) const { return has(slot) && kind[slot] == k; }
+
+    void setBool  (uint32_t s, bool v)        { colBool[s] = v ? 1 : 0; mark(s, VarKind::Bool); }
+    void setInt16 (uint32_t s, int16_t v)     { colI16[s]  = v;         mark(s, VarKind::Int16); }
+    void setFloat (uint32_t s, double v)      { colF64[s]  = v;         mark(s, VarKind::Float); }
+    void setString(uint32_t s, std::string v) { colStr[s]  = std::move(v); mark(s, VarKind::String); }
+
+    // Anzahl gültiger Werte eines Typs (Logging)
+    size_t count(VarKind k) const {
+        size_t n = 0;
+        for (uint32_t s = 0; s < kind.size(); ++s) n += has(s, k) ? 1 : 0;
+        return n;
+    }
+    // f(const NodeKey&, uint32_t slot) für alle gültigen Slots vom Typ k
+    template <class F>
+    void forEach(VarKind k, F&& f) const {
+        for (uint32_t s = 0; s < kind.size(); ++s)
+            if (has(s, k)) f(key(s), s);
+    }
+
+    // Komfort für Einzelzugriffe per NodeKey (ein Hash-Lookup in der NodeTable)
+    const std::string* findString(const NodeKey& k) const {
+        const uint32_t s = slotOf(k);
+        return has(s, VarKind::String) ? &colStr[s] : nullptr;
+    }
+
+private:
+    void mark(uint32_t s, VarKind k) {
+        kind[s] = k;
+        valid[s >> 6] |= (uint64_t{1} << (s & 63));
+    }
 };
 
+// Unveränderlicher, geteilter Snapshot: einmal gebaut, danach von allen Konsumenten
+// (ReactionManager-Worker, FailureRecorder, …) ohne Kopie gelesen.
+using InventorySnapshotPtr = std::shared_ptr<const InventorySnapshot>;
+
+inline InventorySnapshotPtr shareSnapshot(InventorySnapshot&& inv) {
+    return std::make_shared<const InventorySnapshot>(std::move(inv));
+}
+
 // Payload-Typ für evD2 (Correlation + Snapshot)
 // Wird von main/PLCMonitor bei TriggerD2/D3 erzeugt und über den EventBus verschickt.
 struct D2Snapshot {
-    std::string        correlationId;
-    InventorySnapshot  inv;
-};
\ No newline at end of file
+    CorrelationId         correlationId;
+    InventorySnapshotPtr  inv;           // nie null (Erzeuger setzt shareSnapshot(...))
+};
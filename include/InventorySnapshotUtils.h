@@ -1,15 +1,17 @@
 // InventorySnapshotUtils.h – Hilfsfunktionen rund um InventorySnapshot
 //
 // buildInventorySnapshotNow(...):
-//   - browsed vom gegebenen root-Knoten aus den SPS-Adressraum,
-//   - füllt InventorySnapshot.rows (Struktur),
-//   - liest anschließend konkrete Werte (bool/string/int16/double/float)
-//     und trägt sie in die typisierten Maps ein.
+//   - füllt InventorySnapshot.rows (Struktur) aus dem Inventory-Cache des
+//     PLCMonitor (Browse ab root nur beim ersten Mal bzw. nach Modelländerung),
+//   - übernimmt konkrete Werte (bool/string/int16/double/float) aus dem
+//     Live-Spiegel des PLCMonitor (Stand zur Trigger-Flanke edgeSourceTs) bzw.
+//     liest sie ohne Spiegel gebündelt über PLCMonitor::readValuesBatched
+//     und trägt sie in die typisierten Spalten (Slot aus der NodeTable) ein.
 //   - wird u. a. in main.cpp bei TriggerD1/D2/D3 verwendet.
 //
 // dumpInventorySnapshot(...):
 //   - einfache Textausgabe des Snapshots (Debugging, Logging), inkl. aller
-//     rows und Werte-Maps, wie im MPA-Draft zur Nachvollziehbarkeit gefordert.
+//     rows und Werte-Spalten, wie im MPA-Draft zur Nachvollziehbarkeit gefordert.
 
 #pragma once
 #include "InventorySnapshot.h"
@@ -20,9 +22,19 @@
 #include <sstream>
 
 // identisch zur RM-Logik, nur als freie Funktion
+// edgeSourceTs: sourceTimestamp der Trigger-Flanke (0 = aktueller Stand)
 bool buildInventorySnapshotNow(PLCMonitor& mon,
                                const std::string& root,
-                               InventorySnapshot& out); 
+                               InventorySnapshot& out,
+                               UA_DateTime edgeSourceTs = 0);
+
+// Startet den Live-Spiegel des PLCMonitor auf den Slots des Snapshot-Layouts von root
+// (gleiche NodeTable wie buildInventorySnapshotNow -> Werte ohne Lookup slotweise kopiert).
+bool startValueMirrorFor(PLCMonitor& mon,
+                         const std::string& root,
+                         double samplingMs = 0.0,
+                         UA_UInt32 queueSize = 1);
+
                                // Formatiert einen NodeKey in eine gut lesbare Form (z. B. für Logs).
 inline std::string nodeKeyToStr(const NodeKey& k) {
     std::ostringstream os;
@@ -33,28 +45,29 @@ inline std::string nodeKeyToStr(const NodeKey& k) {
 // Praktisches Hilfsmittel, um z. B. D2/D3-Snapshots im Log nachzuvollziehen.
 inline void dumpInventorySnapshot(const InventorySnapshot& inv, std::ostream& os = std::cout) {
     os << "\n=== InventorySnapshot ===\n"
-       << "rows="    << inv.rows.size()
-       << " bools="  << inv.bools.size()
-       << " strings="<< inv.strings.size()
-       << " int16s=" << inv.int16s.size()
-       << " floats=" << inv.floats.size() << "\n";
+       << "rows="    << inv.rowList().size()
+       << " slots="  << inv.slots()
+       << " bools="  << inv.count(VarKind::Bool)
+       << " strings="<< inv.count(VarKind::String)
+       << " int16s=" << inv.count(VarKind::Int16)
+       << " floats=" << inv.count(VarKind::Float) << "\n";
 
     os << "-- rows (NodeClass | NodeId | DType/Signature)\n";
     // Schleife: alle Strukturzeilen (Browse-Ergebnisse) protokollieren.
-    for (const auto& r : inv.rows)
+    for (const auto& r : inv.rowList())
         os << "  " << r.nodeClass << " | " << r.nodeId << " | " << r.dtypeOrSig << "\n";
 
     os << "-- bools\n";
     // Schleife: alle bool-Werte im Snapshot ausgeben.
-    for (const auto& [k,v] : inv.bools)   os << "  " << nodeKeyToStr(k) << " = " << (v ? "true":"false") << "\n";
+    inv.forEach(VarKind::Bool,   [&](const NodeKey& k, uint32_t s){ os << "  " << nodeKeyToStr(k) << " = " << (inv.colBool[s] ? "true":"false") << "\n"; });
     os << "-- strings\n";
     // Schleife: alle string-Werte im Snapshot ausgeben.
-    for (const auto& [k,v] : inv.strings) os << "  " << nodeKeyToStr(k) << " = \"" << v << "\"\n";
+    inv.forEach(VarKind::String, [&](const NodeKey& k, uint32_t s){ os << "  " << nodeKeyToStr(k) << " = \"" << inv.colStr[s] << "\"\n"; });
     os << "-- int16s\n";
     // Schleife: alle int16-Werte im Snapshot ausgeben.
-    for (const auto& [k,v] : inv.int16s)  os << "  " << nodeKeyToStr(k) << " = " << v << "\n";
+    inv.forEach(VarKind::Int16,  [&](const NodeKey& k, uint32_t s){ os << "  " << nodeKeyToStr(k) << " = " << inv.colI16[s] << "\n"; });
     os << "-- floats\n";
     // Schleife: alle float/double-Werte im Snapshot ausgeben.
-    for (const auto& [k,v] : inv.floats)  os << "  " << nodeKeyToStr(k) << " = " << v << "\n";
+    inv.forEach(VarKind::Float,  [&](const NodeKey& k, uint32_t s){ os << "  " << nodeKeyToStr(k) << " = " << inv.colF64[s] << "\n"; });
     os << "=== /InventorySnapshot ===\n";
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+// KGIndex.h – nativer In-Memory-Index des FMEA-Knowledge-Graphen
+//
+// Lädt eine Turtle-Datei (z. B. src/FMEA_KG.ttl) einmal beim Start und baut daraus
+// kompakte Adjazenz-Indizes über internierte IRIs:
+//   Skill (cl:Function)  -> potFM-Liste       (cl:FailureMode, dp:hasFailureModeParams)
+//   FailureMode          -> MonitoringActions (dp:hasMonActParams, ohne checkParameters)
+//   FailureMode          -> SystemReactions   (dp:hasSysReactParams)
+//
+// Die drei Lookups des ReactionManager laufen damit in O(1) ohne GIL/rdflib.
+// Das Antwortformat entspricht KG_Interface.py (IRI und Params-JSON zeilenweise im
+// Wechsel), zusätzlich liegen die "rows" je Eintrag bereits geparst vor.
+//
+// Python bleibt für die Ingestion zuständig; die dort ergänzten Tripel (OccuredFailure,
+// Execution-Stamps) ändern diese drei Lookups nicht.
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+class KGIndex {
+public:
+    // Ein Treffer: potFM / monAct / sysReact mit zugehörigem Parameter-JSON.
+    struct Entry {
+        std::string    iri;
+        std::string    params;   // Roh-JSON wie im KG abgelegt
+        nlohmann::json rows;     // params["rows"] vorab geparst (null, falls nicht vorhanden)
+    };
+
+    static KGIndex& instance() {
+        static KGIndex idx;
+        return idx;
+    }
+
+    // Parst die Turtle-Datei und ersetzt den Index atomar. false bei Lese-/Parsefehler
+    // (ein zuvor geladener Index bleibt dann erhalten).
+    bool loadTurtleFile(const std::string& path);
+
+    bool   loaded() const;
+    size_t tripleCount() const;
+
+    // Antworten im Format von KG_Interface.py. Rückgabe false = Index nicht geladen
+    // (Aufrufer fällt dann auf den Python-Pfad zurück); unbekannte Keys liefern "".
+    bool failureModeParameters(const std::string& skillName, std::string& out) const;
+    bool monitoringActionsForFM(const std::string& fmIri, std::string& out) const;
+    bool systemReactionsForFM(const std::string& fmIri, std::string& out) const;
+
+    // Strukturierter Zugriff (Kopie der Einträge).
+    bool failureModesForSkill(const std::string& skillName, std::vector<Entry>& out) const;
+    bool monitoringActionEntries(const std::string& fmIri, std::vector<Entry>& out) const;
+    bool systemReactionEntries(const std::string& fmIri, std::vector<Entry>& out) const;
+
+    static constexpr const char* kOntIri = "http://www.semanticweb.org/FMEA_VDA_AIAG_2021/";
+
+private:
+    KGIndex() = default;
+    KGIndex(const KGIndex&)            = delete;
+    KGIndex& operator=(const KGIndex&) = delete;
+
+    // Ergebnisliste je Key inkl. vorformatierter Antwort.
+    struct Bucket {
+        std::vector<Entry> entries;
+        std::string        text;
+    };
+    // Unveränderliche Tabellen; ein Reload tauscht nur den shared_ptr.
+    struct Tables {
+        std::vector<std::string>                  iris;    // id -> IRI
+        std::unordered_map<std::string, uint32_t> ids;     // IRI -> id
+        std::unordered_map<uint32_t, Bucket>      bySkill;
+        std::unordered_map<uint32_t, Bucket>      monActByFM;
+        std::unordered_map<uint32_t, Bucket>      sysReactByFM;
+        size_t                                    triples = 0;
+    };
+
+    std::shared_ptr<const Tables> tables() const;
+    static const Bucket* find(const Tables& t,
+                              const std::unordered_map<uint32_t, Bucket>& m,
+                              const std::string& iri);
+
+    mutable std::mutex            mx_;
+    std::shared_ptr<const Tables> tables_;
+};
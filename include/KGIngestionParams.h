@@ -2,11 +2,32 @@
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include "Correlation.h"
+#include "InventorySnapshot.h"   // InventorySnapshotPtr
+
+// Flaches Snapshot-JSON für die Ingestion:
+//   { rows:[{id,t,nodeClass}...], vars:[{id,t:"bool"|"string"|"int16"|"float",v}...] }
+inline nlohmann::json snapshotToFlatJson(const InventorySnapshot& inv) {
+    using nlohmann::json;
+    auto add = [](json& arr, const std::string& id, const char* t, json v) {
+        arr.push_back(json{{"id",id},{"t",t},{"v",std::move(v)}});
+    };
+    json out;
+    json& rows = out["rows"] = json::array();
+    for (const auto& r : inv.rowList())
+        rows.push_back({{"id",r.nodeId},{"t",r.dtypeOrSig},{"nodeClass",r.nodeClass}});
+    json& vars = out["vars"] = json::array();
+    inv.forEach(VarKind::Bool,   [&](const NodeKey& k, uint32_t s){ add(vars, k.id, "bool",   inv.colBool[s] != 0); });
+    inv.forEach(VarKind::String, [&](const NodeKey& k, uint32_t s){ add(vars, k.id, "string", inv.colStr[s]); });
+    inv.forEach(VarKind::Int16,  [&](const NodeKey& k, uint32_t s){ add(vars, k.id, "int16",  inv.colI16[s]); });
+    inv.forEach(VarKind::Float,  [&](const NodeKey& k, uint32_t s){ add(vars, k.id, "float",  inv.colF64[s]); });
+    return out;
+}
 
 struct KgIngestionParams {
     // Meta
     std::string id;
-    std::string corr;
+    CorrelationId corr;
     std::string process;
     std::string summary;
     std::string resourceId;
@@ -14,10 +35,11 @@ struct KgIngestionParams {
 
     // Zeit/Name
     std::string ts;               // "YYYY-MM-DD_HH-mm-ss"
-    std::string individualName;   // corr + "_" + ts
+    std::string individualName;   // corr.str() + "_" + ts
 
-    // Snapshot (bereits vorbereitet)
-    std::string snapshotWrapped;  // "==InventorySnapshot==" + json + "==InventorySnapshot=="
+    // Snapshot: nativ (geteilt mit allen Konsumenten), JSON erst bei der Ingestion
+    InventorySnapshotPtr snapshot;
+    std::string snapshotWrapped;  // "==InventorySnapshot==" + json + "==InventorySnapshot==" (materializeSnapshot)
     std::string lastSkill;        // aus Snapshot (OPCUA.lastExecutedSkill)
     std::string lastProcess;      // aus Snapshot (OPCUA.lastExecutedProcess)
 
@@ -25,10 +47,18 @@ struct KgIngestionParams {
     std::string ExecsysReaction;    // IRIs der ausgeführten System-Reactions
     std::vector<std::string> ExecmonReactions;    // IRIs der ausgeführten Monitoring-Actions
     std::string failureMode;    // optional
+
+    // Serialisiert den Snapshot genau einmal; im PythonWorker aufrufen, nicht auf dem Bus-Thread.
+    void materializeSnapshot() {
+        if (!snapshotWrapped.empty()) return;
+        const std::string js = snapshot ? snapshotToFlatJson(*snapshot).dump() : std::string{};
+        snapshotWrapped = "==InventorySnapshot==" + js + "==InventorySnapshot==";
+    }
+
     nlohmann::json toJson() const {
         using nlohmann::json;
         json j = {
-            {"corr", corr}, {"process", process}, {"summary", summary}, {"resourceId", resourceId},
+            {"corr", corr.str()}, {"process", process}, {"summary", summary}, {"resourceId", resourceId},
             {"ts", ts}, {"individualName", individualName},
             {"snapshot", snapshotWrapped}, {"lastSkill", lastSkill}, {"lastProcess", lastProcess}
         };
@@ -36,7 +66,7 @@ struct KgIngestionParams {
     /*nlohmann::json toJson() const {
         using nlohmann::json;
         return json{
-            {"corr", corr}, {"process", process}, {"summary", summary}, {"resourceId", resourceId},
+            {"corr", corr.str()}, {"process", process}, {"summary", summary}, {"resourceId", resourceId},
             {"ts", ts}, {"individualName", individualName},
             {"snapshot", snapshotWrapped}, {"lastSkill", lastSkill}, {"lastProcess", lastProcess},
             {"sysReactions", sysReactions}, {"monReactions", monReactions}, {"failureModes", failureModes}
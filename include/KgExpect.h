@@ -0,0 +1,27 @@
+// KgExpect.h – Failure-Mode-Kandidaten aus dem KG (Erwartungen an Istwerte)
+// - KgExpect:    eine zu prüfende Variable (NodeKey) mit typisiertem Sollwert.
+// - KgCandidate: potenzielle FailureMode-IRI mit ihren Erwartungen.
+// Erzeugt von KgResponseParser aus den KG-Antworten, im ReactionManager zu
+// CompiledChecks übersetzt (dort als ReactionManager::KgExpect usw. erreichbar).
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "InventorySnapshot.h"   // NodeKey
+
+enum class KgValKind { Bool, Int16, Float64, String };
+
+struct KgExpect {
+    NodeKey     key;
+    KgValKind   kind{KgValKind::Bool};
+    bool        expectedBool{false};
+    int16_t     expectedI16{0};
+    double      expectedF64{0.0};
+    std::string expectedStr;
+};
+
+struct KgCandidate {
+    std::string              potFM;    // IRI/ID der potenziellen FailureMode
+    std::vector<KgExpect>    expects;  // zu prüfende Istwerte (nur gegen Cache!)
+    bool                     malformed = false;   // Params-Block fehlerhaft -> nie Gewinner
+};
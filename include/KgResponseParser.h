@@ -0,0 +1,34 @@
+// KgResponseParser.h – Einlesen der KG-Kandidatenantworten in einem Durchlauf
+//
+// Eingabe wie von KG_Interface.py / KGIndex geliefert: IRI-Zeile und Params-JSON
+// ({"rows":[{"id":…,"t":…,"v":…}, …]}) im Wechsel, ggf. in äußeren Quotes.
+// Der Parser läuft per std::string_view über den Text (JSON on demand, kein DOM,
+// keine Teilstring-Kopien) und erzeugt KgCandidate/KgExpect direkt; Typ-Tags werden
+// ohne Kopie/Kleinschreibung auf KgValKind abgebildet.
+//
+// Akzeptierte JSON-Formen je Block (wie bisher mit nlohmann): {rows:[…]}, [{rows:[…]}]
+// und [header, {rows:[…]}]. Zeilen ohne id/t/v entfallen; ein Block mit Syntaxfehler
+// oder unpassendem Werttyp (z. B. "t":"int16","v":"5") liefert keine Erwartungen und
+// sein Kandidat wird als malformed markiert (kann nie Gewinner werden).
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "KgExpect.h"
+
+// Zähler für Logs
+struct KgParseStats {
+    size_t candidates  = 0;
+    size_t missingJson = 0;   // IRI ohne folgenden JSON-Block
+    size_t malformed   = 0;   // JSON-Block mit Syntax- oder Typfehler
+};
+
+// Typ-Tag ("Int16", "bool", "f", …, Groß-/Kleinschreibung egal) -> KgValKind; sonst String
+KgValKind kgKindOfTag(std::string_view tag);
+
+// Ein JSON-Block -> Erwartungen (angehängt an out). false bei Syntax- oder Typfehler
+// (out bleibt dann unverändert).
+bool parseKgExpects(std::string_view json, std::vector<KgExpect>& out);
+
+// Alle IRI+JSON-Paare einer KG-Antwort -> Kandidaten in Antwortreihenfolge.
+std::vector<KgCandidate> parseKgCandidates(std::string_view srows, KgParseStats* stats = nullptr);
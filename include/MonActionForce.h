@@ -16,21 +16,36 @@ class MonitoringActionForce final : public IWinnerFilter {
 public:
     using Fetcher = std::function<std::string(const std::string& fmIri)>;
 
+    // maxParallel: so viele Kandidaten werden gleichzeitig geprüft (KG-Fetch + Methoden-
+    // aufrufe); 1 = streng nacheinander. Die Methodenaufrufe selbst begrenzt zusätzlich
+    // PLCMonitor::Options::maxConcurrentCalls je SPS.
     MonitoringActionForce(PLCMonitor& mon, EventBus& bus,
                           Fetcher fetch,
-                          unsigned defaultTimeoutMs = 30000);
+                          unsigned defaultTimeoutMs = 30000,
+                          unsigned maxParallel = 4);
 
+    // Reihenfolge der Rückgabe (und der IRIs in MonActFinishedAck) = Reihenfolge in winners,
+    // unabhängig davon, welcher Kandidat zuerst fertig wird.
     std::vector<std::string>
     filter(const std::vector<std::string>& winners,
-           const std::string& correlationId,
+           CorrelationId correlationId,
            const std::string& processNameForAck) override;
 
 private:
+    struct CandidateResult {
+        bool        ok = false;
+        std::string skillIri;   // IRI-Header der MonitoringAction (für MonActFinishedAck)
+    };
+    // Ein Kandidat: MonAction holen, Plan bauen, Schritte ausführen und Outputs prüfen
+    // (corr nur für die Log-Zeilen: Kandidaten verschiedener Korrelationen laufen parallel)
+    CandidateResult evaluateCandidate(const std::string& fm, size_t idx, CorrelationId corr);
+
     // Intern: JSON -> Plan (nur CallMethod, KEIN DiagnoseFinished-Puls)
-    Plan buildPlanFromPayload(const std::string& corr, const std::string& payload);
+    Plan buildPlanFromPayload(CorrelationId corr, const std::string& payload);
 
     PLCMonitor&  mon_;
     EventBus&    bus_;
     Fetcher      fetch_;
     unsigned     defTimeoutMs_;
+    unsigned     maxParallel_;
 };
@@ -8,7 +8,13 @@ class PLCMonitor;
 class PLCCommandForce : public ICommandForce {
 public:
     explicit PLCCommandForce(PLCMonitor& mon, IOrderQueue* oq = nullptr);
+    // Wartezeiten (WaitMs, Preclear bei PulseBool) blockieren den aufrufenden Thread
     int execute(const Plan& p) override;
+    // Wartezeiten laufen als Monitor-Timer (postDelayed); der Plan wird danach im UA-Thread
+    // fortgesetzt, done(rc) kommt vom Thread, der den letzten Schritt ausführt. Die Instanz
+    // darf vor done(...) zerstört werden. Bricht PLCMonitor::disconnect() eine Wartezeit ab,
+    // kommt done(0) aus dem Thread von disconnect().
+    void executeAsync(const Plan& p, Done done) override;
 
 private:
     PLCMonitor&  mon_;
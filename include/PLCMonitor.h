@@ -5,11 +5,18 @@
 #include <functional>
 #include <queue>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <type_traits>
 #include <future>
 #include <map>
+#include <optional>
 #include <variant>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 #include <open62541/client.h>
 #include <open62541/client_config_default.h>
 #include <open62541/client_highlevel.h>
@@ -17,6 +24,9 @@
 #include <open62541/plugin/log_stdout.h>
 #include <open62541/util.h>
 #include "common_types.h"
+#include "InventoryRow.h"
+#include "InventorySnapshot.h"   // NodeTable (Slots des Live-Spiegels)
+#include "TimerWheel.h"
 
 class PLCMonitor {
 public:
@@ -30,11 +40,26 @@ public:
     void post(F&& f) {
         auto fn = std::make_shared<Decayed>(std::forward<F>(f)); // auch move-only
         UaFn job = [fn]() mutable { (*fn)(); };
-        std::lock_guard<std::mutex> lk(qmx_);
-        q_.push(std::move(job));
+        {
+            std::lock_guard<std::mutex> lk(qmx_);
+            q_.push(std::move(job));
+        }
+        wakeup();
     }
     void processPosted(size_t max = 16);
 
+    // ---------- Reactor-Loop ----------
+    // Ein Durchlauf des ereignisgesteuerten Main-Loops: blockiert im EventLoop des UA-Clients
+    // (epoll/select auf dem Socket), bis Daten ankommen, post()/postDelayed()/wakeup()
+    // weckt oder der nächste Timer fällig ist – höchstens maxWaitMs. Danach laufen alle bis
+    // dahin geposteten Jobs und fälligen Timer.
+    UA_StatusCode runOnce(int maxWaitMs = 1000);
+    // Unterbricht ein blockierendes runOnce()/runIterate() sofort (thread-sicher, billig
+    // bei Mehrfachaufruf: höchstens ein Weckruf steht aus).
+    void wakeup();
+    // Millisekunden bis zum nächsten postDelayed-Timer (aufgerundet), höchstens capMs.
+    int msUntilNextTimer(int capMs);
+
     // ---------- Verbindungs-Optionen ----------
     struct Options {
         std::string endpoint;
@@ -44,6 +69,13 @@ public:
         std::string keyDerPath;
         std::string applicationUri;
         UA_UInt16   nsIndex = 2;
+        // Optional: Variable, deren Wert sich bei jedem PLC-Download ändert
+        // (z. B. Compile-Info/Symbolversion von Port_851, "ns=4;s=..."). Wird wie das
+        // NamespaceArray auf der Subscription überwacht und invalidiert den Inventory-Cache.
+        std::string modelVersionNodeId;
+        // Obergrenze gleichzeitig ausstehender Methodenaufrufe gegen diese SPS
+        // (callMethodAsync/callMethodTyped); weitere Aufrufe warten in einer Queue.
+        unsigned    maxConcurrentCalls = 4;
     };
 
     // ---------- ctor/dtor ----------
@@ -58,6 +90,39 @@ public:
     UA_StatusCode runIterate(int timeoutMs = 0);   // vorantreiben (single-thread)
     bool waitUntilActivated(int timeoutMs = 3000); // bis Session aktiv
 
+    // ---------- Methodenaufrufe ----------
+    // Asynchroner Aufruf über den Call-Service: kehrt sofort zurück, der Request wird im
+    // UA-Thread gesendet und die Antwort in runIterate() zugestellt. Mehrere Aufrufe laufen
+    // so gleichzeitig auf einer Session (höchstens Options::maxConcurrentCalls, weitere
+    // warten in einer Queue), Subscriptions werden währenddessen weiter bedient.
+    // cb(status, outputs) läuft im UA-Thread (kurz halten) – auch bei Timeout (BadTimeout)
+    // und Disconnect (BadShutdown); outputs nur bei status == Good gefüllt.
+    using CallCallback = std::function<void(UA_StatusCode, UAValueMap)>;
+    void callMethodAsync(const std::string& objNodeId,
+                         const std::string& methNodeId,
+                         const UAValueMap& inputs,
+                         unsigned timeoutMs,
+                         CallCallback cb);
+
+    // Mehrere unabhängige Methoden in EINEM UA_CallRequest (ein Roundtrip, ein Slot des
+    // Call-Limits). results[i] gehört zu calls[i]; ein Service-Fehler gilt für alle.
+    struct CallSpec {
+        std::string objNodeId;
+        std::string methNodeId;
+        UAValueMap  inputs;
+    };
+    struct CallResult {
+        UA_StatusCode status = UA_STATUSCODE_GOOD;
+        UAValueMap    outputs;
+    };
+    using BatchCallback = std::function<void(std::vector<CallResult>)>;
+    void callMethodsAsync(std::vector<CallSpec> calls, unsigned timeoutMs, BatchCallback cb);
+    // Blockierend; true, wenn alle Aufrufe Good lieferten (Einzelstatus in results).
+    bool callMethodsTyped(const std::vector<CallSpec>& calls,
+                          std::vector<CallResult>& results,
+                          unsigned timeoutMs);
+
+    // Blockierender Komfort-Wrapper um callMethodAsync (nicht aus dem UA-Thread aufrufen).
     bool callMethodTyped(const std::string& objNodeId,
                      const std::string& methNodeId,
                      const UAValueMap& inputs,   // index -> typed value
@@ -81,6 +146,49 @@ public:
                     std::string& outValue, std::string& outTypeName) const;
     bool writeBool(const std::string& nodeIdStr, UA_UInt16 nsIndex, bool v);
 
+    // ---------- Batch-Reads ----------
+    // Ein zu lesender Variablenknoten (String-NodeId + Namespace).
+    struct ReadItem {
+        UA_UInt16   ns = 4;
+        std::string id;          // z. B. "OPCUA.bool1"
+    };
+    // Liest alle Items mit möglichst wenigen UA_ReadRequests (je Request höchstens
+    // maxPerRequest NodesToRead). out[i] gehört zu items[i]; nicht lesbare Knoten oder
+    // nicht abgebildete Datentypen bleiben std::monostate.
+    // Rückgabe false, wenn ein Request als Ganzes fehlschlug (Service-Fehler).
+    bool readValuesBatched(const std::vector<ReadItem>& items,
+                           std::vector<UAValue>& out,
+                           size_t maxPerRequest = 500) const;
+
+    // ---------- Live-Spiegel (Subscription-basiert) ----------
+    // Legt für jeden Slot der NodeTable (Snapshot-Layout eines Inventarstands, siehe
+    // startValueMirrorFor in InventorySnapshotUtils) ein MonitoredItem auf der bestehenden
+    // Subscription an. Spiegel-Slot i gehört zu NodeTable-Slot i und hält aktuellen +
+    // vorherigen Wert inkl. sourceTimestamp; Snapshots brauchen dann keine Reads.
+    // Nur im UA-Thread verwenden (Thread von startValueMirror, der auch runOnce() ausführt);
+    // mirrorValues()/refreshValueMirrorIfStale() liefern aus anderen Threads false.
+    bool startValueMirror(NodeTablePtr nodes, double samplingMs = 0.0, UA_UInt32 queueSize = 1);
+    void stopValueMirror();
+    bool mirrorActive() const;
+    // Neue NodeTable (Inventar nach ModelChange neu aufgebaut): Spiegel mit den bisherigen
+    // Parametern dafür neu aufsetzen. true, wenn danach aktuell.
+    bool refreshValueMirrorIfStale(const NodeTablePtr& nodes);
+    // Kopiert die gespiegelten Werte slotweise: out[slot] für alle Slots von nodes
+    // (gleiche Wertsemantik wie readValuesBatched), ohne Schlüssel-Lookups.
+    // atSourceTs != 0: Wert, der zu diesem Quellzeitstempel galt (z. B. Trigger-Flanke);
+    // ist der aktuelle Wert jünger, wird der vorherige genommen; ist auch der jünger
+    // (zweimal geändert), gilt der Slot als fehlend.
+    // missing (optional) erhält die Slots ohne bisher empfangenen Wert bzw. ohne
+    // bekannten Wert zur Flanke (Aufrufer liest diese nach).
+    // Rückgabe false, wenn der Spiegel nicht aktiv ist, zu einer anderen NodeTable gehört
+    // oder außerhalb des UA-Threads aufgerufen wird (gezählt, siehe mirrorOffThreadCalls).
+    bool mirrorValues(const NodeTablePtr& nodes,
+                      std::vector<UAValue>& out,
+                      UA_DateTime atSourceTs = 0,
+                      std::vector<size_t>* missing = nullptr) const;
+    // Anzahl der mirrorValues()-Aufrufe außerhalb des UA-Threads (dort Batch-Read)
+    UA_UInt64 mirrorOffThreadCalls() const;
+
     // ---------- Subscriptions ----------
     using Int16ChangeCallback = std::function<void(UA_Int16, const UA_DataValue&)>;
     using BoolChangeCallback  = std::function<void(UA_Boolean, const UA_DataValue&)>;
@@ -112,19 +220,36 @@ public:
     // Low-level Zugriff (falls nötig)
     UA_Client* raw() const { return client_; }
 
-    // Alles für Inventory
-    struct InventoryRow {
-    std::string nodeClass;   // "Variable", "Method", "Object"
-    std::string nodeId;      // "ns=4;s=OPCUA.DiagnoseFinished", ...
-    std::string dtypeOrSig;  // z. B. "Boolean" oder "in: [Int32], out: [Int32]"
-    };
+    // Alles für Inventory (Definition in InventoryRow.h)
+    using InventoryRow = ::InventoryRow;
 
     // public:
     bool dumpPlcInventory(std::vector<InventoryRow>& out, const char* plcNameContains = "PLC");
+
+    // ---------- Inventory-Cache ----------
+    // Liefert die Inventory-Zeilen (inkl. aufgelöstem Datentyp/Methodensignatur) aus dem
+    // Cache, geteilt statt kopiert. Neu gebrowsed wird nur beim ersten Aufruf, bei anderem
+    // plcNameContains oder nachdem watchModelChanges() eine Modelländerung gemeldet hat
+    // (ModelChange-Event bzw. geänderte Modellversion); ein Treffer kostet keinen Read.
+    bool inventoryCached(InventoryRowsPtr& out, const char* plcNameContains = "PLC");
+    void invalidateInventoryCache();
+    // Zählt jeden Neuaufbau des Inventory-Caches (für abgeleitete Caches, z. B. NodeTable)
+    UA_UInt64 inventoryGeneration() const;
+    // Event-MonitoredItem auf dem Server-Objekt: (General)ModelChange-/SemanticChange-
+    // Events invalidieren den Inventory-Cache; ebenso jede Änderung von NamespaceArray bzw.
+    // Options::modelVersionNodeId (DataChange-MonitoredItems auf derselben Subscription).
+    bool watchModelChanges();
     void printInventoryTable(const std::vector<InventoryRow>& rows) const;
 
-    void postDelayed(int delayMs, UaFn fn);
+    // Timer im UA-Thread (Ablauf über processPosted()/runOnce()); bis zum Ablauf mit
+    // cancelDelayed() zurückziehbar (false, wenn schon gelaufen oder abgebrochen).
+    // onDrop läuft statt fn, wenn disconnect() den Timer verwirft (im Thread von disconnect()).
+    using TimerId = TimerWheel::Handle;
+    TimerId postDelayed(int delayMs, UaFn fn, UaFn onDrop = {});
+    bool cancelDelayed(TimerId id);
     void processTimers();
+    // Frühester Zeitpunkt, zu dem processTimers() etwas tun muss (nullopt ohne Timer)
+    std::optional<std::chrono::steady_clock::time_point> nextTimerDeadline();
     bool callJob(const std::string& objNodeId,
              const std::string& methNodeId,
              UA_Int32 x, UA_Int32& yOut,
@@ -133,13 +258,31 @@ private:
     std::mutex qmx_;
     std::queue<UaFn> q_;
 
-    using UaFn = std::function<void()>;
-    struct TimedFn { std::chrono::steady_clock::time_point due; UaFn fn; };
+    // Ausstehende Methodenaufrufe (nur im UA-Thread angefasst)
+    struct AsyncCall;
+    std::deque<std::unique_ptr<AsyncCall>> callPending_;   // warten auf freien Slot
+    unsigned                               callsInFlight_{0};
+    bool                                   callsClosing_{false};
+    void startCall_(std::unique_ptr<AsyncCall> c);
+    void startPendingCalls_();
+    static void asyncCallDone_(UA_Client*, void* userdata, UA_UInt32 requestId, void* response);
 
+    using UaFn = std::function<void()>;
     std::mutex tmx_;
-    std::vector<TimedFn> timers_;
+    TimerWheel timers_;                                   // Ticks = ms seit timerEpoch_
+    const std::chrono::steady_clock::time_point timerEpoch_ = std::chrono::steady_clock::now();
     std::atomic<bool> running_{false};
 
+    // Weckruf für runOnce(): ein wiederverwendeter DelayedCallback im EventLoop des Clients
+    // unterbricht dessen Warten; ohne Client wartet runOnce() auf wakecv_.
+    std::atomic<bool>       wakePending_{false};   // Weckruf seit letztem runOnce()
+    std::atomic<bool>       wakeDcQueued_{false};  // wakeDc_ hängt im EventLoop
+    std::mutex              wakemx_;               // schützt wakeEl_ gegen disconnect()
+    std::condition_variable wakecv_;
+    UA_EventLoop*           wakeEl_ = nullptr;
+    UA_DelayedCallback      wakeDc_{};
+    static void wakeCb_(void* application, void* context);
+
     static bool loadFileToByteString(const std::string& path, UA_ByteString &out);
 
     Options    opt_;
@@ -157,4 +300,44 @@ private:
     std::unordered_map<UA_UInt32, BoolChangeCallback> boolCbs_;
 
     static void dataChangeHandler(UA_Client*, UA_UInt32, void*, UA_UInt32, void*, UA_DataValue*);
+
+    bool ensureSubscription();
+
+    // Inventory-Cache (Zugriff i. d. R. aus dem UA-Thread; Mutex für Sicherheit)
+    mutable std::mutex        invmx_;
+    InventoryRowsPtr          invRows_;
+    std::string               invRoot_;
+    bool                      invValid_{false};
+    std::atomic<bool>         invDirty_{false};   // gesetzt von ModelChange-Event / Versionsänderung
+    UA_UInt32                 monIdModelChange_{0};
+
+    UA_UInt64                 invGeneration_{0};   // +1 je Neuaufbau des Caches
+
+    // Versionsmarke (NamespaceArray bzw. modelVersionNodeId) als MonitoredItem; der erste
+    // Wert wird nur gemerkt, jede spätere Änderung setzt invDirty_ (nur im UA-Thread)
+    struct VersionWatch {
+        PLCMonitor* self = nullptr;
+        UA_UInt32   monId = 0;
+        bool        seen = false;
+        UA_Variant  last{};
+    };
+    VersionWatch              verWatch_[2];        // [0] NamespaceArray, [1] modelVersionNodeId
+    bool watchVersionNode_(const UA_NodeId& node, VersionWatch& w);
+    void clearVersionWatches_();
+    static void versionChangeHandler(UA_Client*, UA_UInt32, void*, UA_UInt32, void*, UA_DataValue*);
+
+    // Live-Spiegel: mirSlots_[i] gehört zu mirNodes_->keys[i] (Definition in PLCMonitor.cpp).
+    // Größe wird nur in start/stopValueMirror geändert (Adressen sind MonitoredItem-Kontext).
+    struct MirrorSlot;
+    std::vector<MirrorSlot>                    mirSlots_;
+    NodeTablePtr                               mirNodes_;
+    std::vector<UA_UInt32>                     mirMonIds_;
+    mutable std::atomic<UA_UInt64>             mirOffThread_{0};
+    double                                     mirSamplingMs_{0.0};
+    UA_UInt32                                  mirQueueSize_{1};
+    std::atomic<bool>                          mirActive_{false};
+    std::thread::id                            mirThread_{};   // UA-Thread (Besitzer des Spiegels)
+    static void mirrorDataChangeHandler(UA_Client*, UA_UInt32, void*, UA_UInt32, void*, UA_DataValue*);
+    static void modelChangeEventHandler(UA_Client*, UA_UInt32, void*, UA_UInt32, void*,
+                                        size_t, UA_Variant*);
 };
@@ -16,6 +16,7 @@
 #include <map>  
 #include <any>             
 #include "common_types.h"    // UAValue, UAValueMap (neu)
+#include "Correlation.h"     // CorrelationId
 
 /// Primitive, aus denen ein Reaktionsplan besteht.
 enum class OpType {
@@ -65,6 +66,16 @@ struct Operation {
     // CallMethod:  Call-Timeout (Client->config->timeout)
     int           timeoutMs = 0;
 
+    // CallMethod: Schritt hängt nicht von seinen Nachbarn ab. Aufeinanderfolgende
+    // unabhängige CallMethod-Schritte werden in einem UA_CallRequest gebündelt
+    // (KG-Zeile g="meta", k="independent", v=true).
+    bool          independent = false;
+
+    // Schrittgruppe (-1 = keine): aufeinanderfolgende Schritte mit derselben group >= 0
+    // haben untereinander keine Reihenfolge und laufen gleichzeitig; zwischen zwei
+    // Gruppen liegt eine Barriere (KG-Zeile g="meta", k="group", v=<int>).
+    int           group = -1;
+
     
     // Opaque Cargo für spezielle OpTypes (z. B. KGIngestion)
     // Hier legen wir ein std::shared_ptr<KgIngestionParams> ab.
@@ -73,9 +84,33 @@ struct Operation {
 
 /// Gesamter Reaktionsplan …
 struct Plan {
-    std::string              correlationId;
+    CorrelationId            correlationId;
     std::string              resourceId;
     std::vector<Operation>   ops;
     bool                     abortRequired  = false;
     bool                     degradeAllowed = false;
-};
\ No newline at end of file
+};
+
+/// Ende (exklusiv) der Call-Gruppe, die bei ops[i] beginnt: bei einem unabhängigen
+/// CallMethod-Schritt alle direkt folgenden unabhängigen CallMethod-Schritte, sonst i+1.
+inline size_t callBatchEnd(const std::vector<Operation>& ops, size_t i) {
+    if (i >= ops.size()) return i;
+    const auto batchable = [](const Operation& o) {
+        return o.type == OpType::CallMethod && o.independent;
+    };
+    if (!batchable(ops[i])) return i + 1;
+    size_t j = i + 1;
+    while (j < ops.size() && batchable(ops[j])) ++j;
+    return j;
+}
+
+/// Ende (exklusiv) der Schrittgruppe, die bei ops[i] beginnt: alle direkt folgenden
+/// Schritte mit derselben group (>= 0), ohne group die Call-Gruppe nach callBatchEnd.
+inline size_t stepGroupEnd(const std::vector<Operation>& ops, size_t i) {
+    if (i >= ops.size()) return i;
+    const int g = ops[i].group;
+    if (g < 0) return callBatchEnd(ops, i);
+    size_t j = i + 1;
+    while (j < ops.size() && ops[j].group == g) ++j;
+    return j;
+}
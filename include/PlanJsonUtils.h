@@ -7,6 +7,8 @@
 //   - Pro Zeile steuern Felder wie step, g, k, t, i, v die Abbildung auf:
 //       * inputs   (UAValueMap)  – Eingabeargumente der OPC-UA-Methoden
 //       * expOuts  (UAValueMap)  – erwartete Ausgabewerte
+//       * independent (g=meta, k=independent) – Schritt darf gebündelt werden
+//       * group (g=meta, k=group) – Schrittgruppe, gleichzeitig ausführbar
 //   - Typisierte Werte werden aus dem Typ-Tag t mit parseUAValueFromTypeTag(...)
 //     gewonnen und via assignTyped(...) in UAValueMap eingetragen.
 //
@@ -14,8 +16,13 @@
 //   - MonitoringActionForce (MonitoringActions) und
 //   - SystemReactionForce   (SystemReactions)
 // ausgeführt und über PLCMonitor::callMethodTyped an die SPS delegiert.
+//
+// Da sich die Payload einer MonAct/SysReact-IRI nur mit dem KG ändert, liefert
+// compiledCallMethodPlan(...) gecachte, unveränderliche Plan-Vorlagen (ohne
+// correlationId); die CorrelationId reicht der Aufrufer beim Ausführen selbst durch.
 
 #pragma once
+#include <memory>
 #include <string>
 #include <nlohmann/json.hpp>
 #include "Plan.h"
@@ -38,7 +45,19 @@ void           assignTyped(UAValueMap& target, int idx, const std::string& t, co
 // appendPulse : steuert, ob am Ende ein Abschluss-Puls (DiagnoseFinished) ergänzt wird.
 // resourceId  : logische Ressource, die im Plan gesetzt wird (Standard "Station").
 
-Plan buildCallMethodPlanFromPayload(const std::string& corr,
+Plan buildCallMethodPlanFromPayload(CorrelationId corr,
                                     const std::string& payload,
                                     bool appendPulse = true,
                                     const std::string& resourceId = "Station");
+
+// --- Gecachte Variante: Plan-Vorlage je (IRI, Payload-Hash)
+// * Vorlage = buildCallMethodPlanFromPayload(CorrelationId{}, payload, appendPulse, resourceId)
+// * gleiche IRI mit geänderter Payload ersetzt den Eintrag; Hash-Treffer werden
+//   gegen die gespeicherte Payload geprüft
+// * thread-sicher (MonitoringActions prüfen Kandidaten parallel)
+std::shared_ptr<const Plan> compiledCallMethodPlan(const std::string& payload,
+                                                   bool appendPulse = true,
+                                                   const std::string& resourceId = "Station");
+
+// Verwirft alle Vorlagen (KG neu geladen, vgl. KGIndex::loadTurtleFile).
+void invalidateCompiledPlans();
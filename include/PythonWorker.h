@@ -1,52 +1,106 @@
 #pragma once
 #include <pybind11/embed.h>
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
+#include <vector>
 #include <future>
+#include <stdexcept>
 #include <type_traits>
 #include <memory>
 #include <atomic>
+#include <cstdint>
+#include <string>
+#include <iostream>
 
 namespace py = pybind11;
 
+// Pool von KG-Worker-Threads für den eingebetteten Interpreter.
+// - Jobs tragen Priorität (High vor Normal vor Low, innerhalb gleicher Priorität FIFO)
+//   und optional eine Deadline: ein Job, der bis dahin nicht gestartet wurde, wird
+//   verworfen (DeadlineExceeded beim Aufrufer) statt verspätet ausgeführt. Die Deadline
+//   begrenzt nur die Wartezeit in der Queue, nicht die Laufzeit eines gestarteten Jobs.
+// - Jeder Job holt den GIL selbst; alle Threads teilen einen Interpreter, Python-Code
+//   läuft also nie parallel (kein Mehrkern-Gewinn). KG-Abfragen nehmen in KGInterface
+//   nur eine Lesesperre und laufen daher verzahnt gleichzeitig: ein kurzer Lookup muss
+//   nicht warten, bis eine langsame Abfrage fertig ist, teilt sich aber die CPU mit ihr.
+//   Ingestion (Einfügen + Journal) und Compactor-Rotation sind exklusiv (Schreibsperre).
 class PythonWorker {
 public:
+    enum class Priority : int { Low = 0, Normal = 1, High = 2 };
+
+    struct DeadlineExceeded : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    using Clock    = std::chrono::steady_clock;
+    using Deadline = std::chrono::milliseconds;   // 0 = keine Deadline
+
     static PythonWorker& instance() {
         static PythonWorker w;
         return w;
     }
 
-    // Startet den Worker-Thread (einmalig)
-    void start() {
+    // Startet die Worker-Threads (einmalig); threads = Poolgröße (mind. 1)
+    void start(size_t threads = 1) {
         std::lock_guard<std::mutex> lk(mx_);
         if (running_) return;
         running_ = true;
-        th_ = std::thread([this]{ run_(); });
+        threads = (std::max)(threads, size_t{1});
+        for (size_t i = 0; i < threads; ++i)
+            th_.emplace_back([this]{ run_(); });
     }
 
-    // Stop + join (vor Programmende aufrufen)
+    // Stop + join (vor Programmende aufrufen).
+    // Ab hier werden neue Jobs abgewiesen; bereits eingereihte (z. B. Ingestion per post)
+    // laufen noch zu Ende, erst danach wird die KG-Session geschlossen.
     void stop() {
-        {
-            std::lock_guard<std::mutex> lk(mx_);
-            running_ = false;
+        std::unique_lock<std::mutex> lk(mx_);
+        closing_ = true;
+        if (running_) {
+            idle_.wait(lk, [&]{ return q_.empty() && active_ == 0; });
+            lk.unlock();
+            // Compactor stoppen + letzte Deltas ins TTL, dann Instanz mit GIL freigeben
+            auto done = std::make_shared<std::promise<void>>();
+            auto fut  = done->get_future();
+            enqueue_(Priority::Low, Deadline{0}, [this, done](bool) {
+                try {
+                    py::gil_scoped_acquire gil;
+                    kgClosed_ = true;
+                    if (kg_) { kg_->attr("close")(); kg_.reset(); }
+                } catch (const std::exception& e) {
+                    std::cerr << "[KG] close failed: " << e.what() << "\n";
+                }
+                done->set_value();
+            }, /*internal=*/true);
+            fut.wait();
+            lk.lock();
         }
-        cv_.notify_one();
-        if (th_.joinable()) th_.join();
-        workerId_ = std::thread::id{};
+        running_ = false;
+        lk.unlock();
+        cv_.notify_all();
+        for (auto& t : th_) if (t.joinable()) t.join();
+        th_.clear();
     }
 
-    // Führe einen Job im Python-Thread aus und liefere das Ergebnis zurück.
+    size_t poolSize() const { return th_.size(); }
+
+    // Führe einen Job im Pool aus und liefere das Ergebnis zurück.
     // - Holt im Worker pro Job den GIL (gil_scoped_acquire).
-    // - Reentrancy-Guard: Wird aus dem Worker selbst aufgerufen, läuft f() direkt.
+    // - Reentrancy-Guard: Wird aus einem Worker selbst aufgerufen, läuft f() direkt.
+    // - deadline > 0: startet der Job nicht rechtzeitig, wirft fut.get() DeadlineExceeded.
+    //   Ein bereits laufender Job wird nicht abgebrochen (f darf Referenzen auf den
+    //   Aufrufer-Stack halten, daher wartet call() immer bis zum Ende).
     template <class F>
-    auto call(F&& f) -> std::invoke_result_t<F&> {
+    auto call(F&& f, Priority prio = Priority::Normal, Deadline deadline = Deadline{0})
+        -> std::invoke_result_t<F&> {
         using R = std::invoke_result_t<F&>;
 
         // Wenn wir *im* Worker-Thread sind: direkt ausführen (GIL ist dort beim Job aktiv).
-        if (std::this_thread::get_id() == workerId_) {
+        if (inWorker()) {
             if constexpr (std::is_void_v<R>) { f(); return; }
             else { return f(); }
         }
@@ -56,50 +110,165 @@ public:
         auto prom = std::make_shared<std::promise<R>>();
         auto fut  = prom->get_future();
 
-        {
-            std::lock_guard<std::mutex> lk(mx_);
-            q_.emplace([fn = std::move(fn), prom = std::move(prom)]() mutable {
-                try {
-                    py::gil_scoped_acquire gil; // GIL *pro Job*
-                    if constexpr (std::is_void_v<R>) { (*fn)(); prom->set_value(); }
-                    else { prom->set_value((*fn)()); }
-                } catch (...) {
-                    prom->set_exception(std::current_exception());
-                }
-            });
-        }
-        cv_.notify_one();
+        const bool queued = enqueue_(prio, deadline, [fn = std::move(fn), prom = std::move(prom)](bool expired) mutable {
+            if (expired) {
+                prom->set_exception(std::make_exception_ptr(
+                    DeadlineExceeded("PythonWorker: deadline exceeded before start")));
+                return;
+            }
+            try {
+                py::gil_scoped_acquire gil; // GIL *pro Job*
+                if constexpr (std::is_void_v<R>) { (*fn)(); prom->set_value(); }
+                else { prom->set_value((*fn)()); }
+            } catch (...) {
+                prom->set_exception(std::current_exception());
+            }
+        });
+        if (!queued) throw std::runtime_error("PythonWorker: stopped, job rejected");
 
         if constexpr (std::is_void_v<R>) { fut.get(); }
         else { return fut.get(); }
     }
 
+    // Fire-and-forget: Job im Pool einreihen, ohne auf das Ergebnis zu warten.
+    // Exceptions werden geloggt (es gibt keinen Aufrufer, der sie abholen könnte).
+    template <class F>
+    void post(F&& f, Priority prio = Priority::Low, Deadline deadline = Deadline{0}) {
+        auto fn = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
+        const bool queued = enqueue_(prio, deadline, [fn = std::move(fn)](bool expired) mutable {
+            if (expired) {
+                std::cerr << "[PythonWorker] posted job dropped (deadline exceeded)\n";
+                return;
+            }
+            try {
+                py::gil_scoped_acquire gil; // GIL *pro Job*
+                (*fn)();
+            } catch (const std::exception& e) {
+                std::cerr << "[PythonWorker] posted job failed: " << e.what() << "\n";
+            } catch (...) {
+                std::cerr << "[PythonWorker] posted job failed (unknown)\n";
+            }
+        });
+        if (!queued) std::cerr << "[PythonWorker] posted job rejected (stopped)\n";
+    }
+
+    // ---------- KG-Session ----------
+    // Erzeugt einmalig die langlebige KGInterface-Instanz (TTL wird genau einmal geparst,
+    // SPARQL-Queries vorbereitet) und wärmt sie auf. srcDir kommt vorne in sys.path,
+    // ttlPath leer = Default-Pfad aus KG_Interface.py. Blockiert bis fertig.
+    bool startKgSession(const std::string& srcDir, const std::string& ttlPath = {}) {
+        try {
+            return call([&]() -> bool {
+                py::module_ sys  = py::module_::import("sys");
+                py::list    path = sys.attr("path").cast<py::list>();
+                if (!srcDir.empty() && !path.contains(py::cast(srcDir)))
+                    path.insert(0, py::cast(srcDir));
+
+                py::module_ mod = py::module_::import("KG_Interface");
+                py::object  kgi = ttlPath.empty() ? mod.attr("KGInterface")()
+                                                  : mod.attr("KGInterface")(ttlPath);
+                const auto triples = kgi.attr("warmUp")().cast<long long>();
+                kg_ = std::make_unique<py::object>(std::move(kgi));
+                std::cout << "[KG] session ready, triples=" << triples << "\n";
+                return true;
+            });
+        } catch (const std::exception& e) {
+            std::cerr << "[KG] startKgSession failed: " << e.what() << "\n";
+            return false;
+        }
+    }
+
+    // Zugriff auf die KG-Session – NUR innerhalb eines call(...)/post(...)-Jobs (GIL gehalten).
+    // Ohne vorheriges startKgSession wird die Instanz hier lazy mit Defaults angelegt,
+    // nach stop() nicht mehr (kein erneutes TTL-Parsen / zweiter Compactor beim Beenden).
+    py::object& kg() {
+        if (kgClosed_) throw std::runtime_error("PythonWorker: KG session closed");
+        if (!kg_) {
+            py::object kgi = py::module_::import("KG_Interface").attr("KGInterface")();
+            // Konstruktor kann den GIL abgeben -> erst danach prüfen/zuweisen (GIL gehalten)
+            if (!kg_) kg_ = std::make_unique<py::object>(std::move(kgi));
+        }
+        return *kg_;
+    }
+
 private:
     PythonWorker() = default;
-    ~PythonWorker() = default;
+    // kg_ bewusst nicht im statischen Destruktor freigeben (Interpreter ist dann schon weg);
+    // sauber freigegeben wird sie in stop().
+    ~PythonWorker() { (void)kg_.release(); }
     PythonWorker(const PythonWorker&)            = delete;
     PythonWorker& operator=(const PythonWorker&) = delete;
 
+    struct Job {
+        int                       prio = 0;
+        std::uint64_t             seq  = 0;
+        Clock::time_point         deadline = Clock::time_point::max();
+        std::function<void(bool)> run;       // Argument: expired
+    };
+    // Heap-Ordnung: höhere Priorität zuerst, bei Gleichstand ältere Jobs zuerst
+    struct JobLess {
+        bool operator()(const Job& a, const Job& b) const {
+            if (a.prio != b.prio) return a.prio < b.prio;
+            return a.seq > b.seq;
+        }
+    };
+
+    static bool& inWorker() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    // false = abgewiesen (stop() läuft bzw. ist durch); internal nur für stop() selbst
+    bool enqueue_(Priority prio, Deadline deadline, std::function<void(bool)> run, bool internal = false) {
+        Job j;
+        j.prio = static_cast<int>(prio);
+        j.run  = std::move(run);
+        if (deadline.count() > 0) j.deadline = Clock::now() + deadline;
+        {
+            std::lock_guard<std::mutex> lk(mx_);
+            if (closing_ && !internal) return false;
+            j.seq = nextSeq_++;
+            q_.push_back(std::move(j));
+            std::push_heap(q_.begin(), q_.end(), JobLess{});
+        }
+        cv_.notify_one();
+        return true;
+    }
+
     void run_() {
-        workerId_ = std::this_thread::get_id();
+        inWorker() = true;
         for (;;) {
-            std::function<void()> job;
+            Job job;
             {
                 std::unique_lock<std::mutex> lk(mx_);
                 cv_.wait(lk, [&]{ return !running_ || !q_.empty(); });
                 if (!running_ && q_.empty()) break;
-                job = std::move(q_.front());
-                q_.pop();
+                std::pop_heap(q_.begin(), q_.end(), JobLess{});
+                job = std::move(q_.back());
+                q_.pop_back();
+                ++active_;
             }
             // Job ausführen; GIL wird im Job-Lambda geholt
-            try { job(); } catch (...) { /* Exception kommt via future beim Aufrufer an */ }
+            const bool expired = Clock::now() > job.deadline;
+            try { job.run(expired); } catch (...) { /* Exception kommt via future beim Aufrufer an */ }
+            job.run = nullptr;   // Captures freigeben, bevor stop() weiterlaufen darf
+            {
+                std::lock_guard<std::mutex> lk(mx_);
+                --active_;
+            }
+            idle_.notify_all();
         }
     }
 
-    std::thread th_;
+    std::vector<std::thread> th_;
     std::mutex mx_;
     std::condition_variable cv_;
-    std::queue<std::function<void()>> q_;
+    std::condition_variable idle_;             // stop(): Queue leer und kein Job aktiv
+    std::vector<Job> q_;                       // Binär-Heap (JobLess)
+    std::uint64_t nextSeq_{0};
+    size_t active_{0};                         // gerade laufende Jobs (unter mx_)
+    bool closing_{false};                      // stop() begonnen: neue Jobs abweisen (unter mx_)
     std::atomic<bool> running_{false};
-    std::thread::id workerId_{};
+    std::unique_ptr<py::object> kg_;   // langlebige KGInterface-Instanz (nur mit GIL anfassen)
+    bool kgClosed_{false};             // nach stop(): kg() legt keine neue Instanz an (nur mit GIL)
 };
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <queue>
@@ -19,10 +20,15 @@
 #include "PLCMonitor.h"
 #include "Plan.h"
 #include "InventorySnapshot.h"   // NodeKey, InventorySnapshot, D2Snapshot
+#include "CompiledChecks.h"
+#include "KgExpect.h"
 
 class EventBus;
 
-class ReactionManager : public ReactiveObserver {
+// Über std::make_shared anlegen: laufende Pläne setzen sich nur fort, solange die Instanz lebt
+// (Continuations halten eine weak_ptr).
+class ReactionManager : public ReactiveObserver,
+                        public std::enable_shared_from_this<ReactionManager> {
 public:
     enum class LogLevel { Error=0, Warn=1, Info=2, Debug=3, Trace=4, Verbose=5 };
 
@@ -36,16 +42,10 @@ public:
     bool isEnabled(LogLevel lvl) const { return static_cast<int>(lvl) <= logLevel_.load(std::memory_order_relaxed); }
 
     // ---- Vergleich/Normalisierung aus KG ------------------------------------
-    enum class KgValKind { Bool, Int16, Float64, String };
-
-    struct KgExpect {
-        NodeKey     key;
-        KgValKind   kind{KgValKind::Bool};
-        bool        expectedBool{false};
-        int16_t     expectedI16{0};
-        double      expectedF64{0.0};
-        std::string expectedStr;
-    };
+    // Kandidaten-Typen liegen in KgExpect.h (auch ohne ReactionManager nutzbar)
+    using KgValKind   = ::KgValKind;
+    using KgExpect    = ::KgExpect;
+    using KgCandidate = ::KgCandidate;
 
     struct ComparisonItem {
         NodeKey     key;
@@ -57,11 +57,6 @@ public:
         std::vector<ComparisonItem> items;
     };
 
-    struct KgCandidate {
-        std::string              potFM;    // IRI/ID der potenziellen FailureMode
-        std::vector<KgExpect>    expects;  // zu prüfende Istwerte (nur gegen Cache!)
-    };
-
 private:
     // --- Umgebung
     PLCMonitor& mon_;
@@ -72,6 +67,7 @@ private:
     std::mutex               job_mx_;
     std::condition_variable  job_cv_;
     std::queue<std::function<void(std::stop_token)>> jobs_;
+    void enqueueJob(std::function<void(std::stop_token)> job);
 
     // --- Logging
     std::atomic<int> logLevel_{static_cast<int>(LogLevel::Info)};
@@ -79,7 +75,6 @@ private:
     std::ostream& log(LogLevel lvl) const;
 
     // --- Hilfen
-    static std::string makeCorrelationId(const char* evName);
     static std::ostream& nullout();
     mutable std::ostream* nullout_ = nullptr;
 
@@ -90,21 +85,46 @@ private:
     static std::string getStringFromCache(const InventorySnapshot& inv, uint16_t ns, const std::string& id);
     static std::string getLastExecutedSkill(const InventorySnapshot& inv); // **nur Cache**, kein UA-Read
 
+    // Vorkompilierte Kandidaten je Skill (KG-Antwort + Inventarstand), nur im Worker genutzt
+    struct CompiledCandidates {
+        size_t                   srcHash = 0;  // Hash der KG-Antwort (Text bzw. IRI/Params-Paare)
+        std::vector<KgCandidate> cands;    // Klartext für Reports/Logging
+        CompiledChecks           checks;   // Index = Kandidat in cands
+    };
+    using CompiledCandidatesPtr = std::shared_ptr<const CompiledCandidates>;
+    std::mutex compiled_mx_;
+    std::unordered_map<std::string, CompiledCandidatesPtr> compiled_;
+    // parse() läuft nur, wenn für (skill, srcHash, Inventarstand) nichts vorliegt
+    CompiledCandidatesPtr compileCandidates(const std::string& skill, size_t srcHash,
+                                            const std::function<std::vector<KgCandidate>()>& parse,
+                                            const InventorySnapshot& inv);
+
     // KG-Anbindung (Python)
-    std::string fetchFailureModeParameters(const std::string& skillName);
+    // Python-Pfad für die potFM-Liste: (IRI, Params)-Tupel, unter dem GIL direkt typisiert
+    struct KgCandidateSet {
+        size_t                   srcHash = 0;
+        std::vector<KgCandidate> cands;
+    };
+    KgCandidateSet fetchFailureModeCandidates(const std::string& skillName);
     std::string fetchMonitoringActionForFM(const std::string& fmIri);
     std::string fetchSystemReactionForFM(const std::string& fmIri);
 
     // Normalisieren & Entscheiden
     static std::vector<KgExpect>    normalizeKgResponse(const std::string& rowsJson);
     std::vector<KgCandidate> normalizeKgPotFM(const std::string& rowsJson);
+    // Ausführlicher Vergleich mit Text je Erwartung – nur für Debug-Reports, der
+    // Entscheidungspfad nutzt CompiledChecks.
     ComparisonReport         compareAgainstCache(const InventorySnapshot& inv, const std::vector<KgExpect>& expects);
     std::vector<KgCandidate> selectPotFMByChecks(const InventorySnapshot& inv,
                                                         const std::vector<KgCandidate>& cands);
 
     // Plan-Erstellung & -Ausführung
-    Plan buildPlanFromComparison(const std::string& corr, const ComparisonReport& rep) const;
+    Plan buildPlanFromComparison(CorrelationId corr, const ComparisonReport& rep) const;
     void createCommandForceForPlanAndAck(const Plan& plan,
                                          bool checksOk,
                                          const std::string& processNameForFail);
+    // Schritt k des Plans per ICommandForce::executeAsync; die Fortsetzung läuft wieder als
+    // Worker-Job, am Ende folgen die Acks (ProcessFail ohne CallMethod, SRDone).
+    void executePlanFrom(std::shared_ptr<const Plan> plan, size_t k, bool allOk,
+                         std::string processNameForFail);
 };
@@ -11,19 +11,32 @@ class SystemReactionForce final : public IWinnerFilter {
 public:
     using Fetcher = std::function<std::string(const std::string& fmIri)>;
 
+    // maxParallel: höchstens so viele Schritte einer Schrittgruppe gleichzeitig
     SystemReactionForce(PLCMonitor& mon, EventBus& bus,
                         Fetcher fetch,
-                        unsigned defaultTimeoutMs = 30000);
+                        unsigned defaultTimeoutMs = 30000,
+                        unsigned maxParallel = 4);
 
-    // Gleiches Interface wie bei MonitoringActionForce:
+    // Gleiches Interface wie bei MonitoringActionForce. Blockiert, bis alle Pläne durch
+    // sind (über filterAsync; nicht aus dem UA-Thread aufrufen).
     std::vector<std::string>
     filter(const std::vector<std::string>& winners,
-           const std::string& correlationId,
+           CorrelationId correlationId,
            const std::string& processNameForAck) override;
 
+    // Holt die Payloads (KG) im Aufrufer, danach läuft alles ohne blockierende Wartezeiten:
+    // Call-Gruppen per callMethodsAsync, Pulse/Writes/WaitMs per PLCCommandForce::executeAsync.
+    // done(kept) kommt aus dem UA-Thread (bzw. sofort, wenn nichts zu warten ist); die
+    // Instanz darf vorher zerstört werden.
+    void filterAsync(const std::vector<std::string>& winners,
+                     CorrelationId correlationId,
+                     const std::string& processNameForAck,
+                     Done done) override;
+
 private:
     PLCMonitor&  mon_;
     EventBus&    bus_;
     Fetcher      fetch_;
     unsigned     defTimeoutMs_;
+    unsigned     maxParallel_;
 };
\ No newline at end of file
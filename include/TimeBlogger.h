@@ -5,11 +5,11 @@
 #include <vector>
 #include <chrono>
 #include <memory>
-#include <any>
 #include "ReactiveObserver.h"
 #include "Event.h"     // Event, EventType (ev*-Typen)  
 #include "Acks.h"      // Ack-Structs mit correlationId  
 #include "WriteCsvParams.h"
+#include "Correlation.h"
 
 class EventBus;
 
@@ -29,13 +29,13 @@ public:
     void onEvent(const Event& ev) override;
 
     // (optional) manuelle Marken
-    void mark(const std::string& corrId, const std::string& label);
-    bool delta(const std::string& corrId, const std::string& fromLabel,
+    void mark(CorrelationId corrId, const std::string& label);
+    bool delta(CorrelationId corrId, const std::string& fromLabel,
                const std::string& toLabel, DurationMs& out) const;
-    void finish(const std::string& corrId);
+    void finish(CorrelationId corrId);
 
 private:
-    void printAndCollect_(const std::string& corr,
+    void printAndCollect_(CorrelationId corr,
                       const std::string& evName,
                       long long durMs,
                       long long sumMs);
@@ -52,13 +52,13 @@ private:
     
 
     // Helfer
-    static std::string extractCorrId_(const Event& ev);
+    static CorrelationId extractCorrId_(const Event& ev);
     static const char* toName_(EventType t);
     void recordSegment_(Timeline& tl, const std::string& from, const std::string& to);
-    void handleEvent_(const Event& ev, const std::string& corrId, const char* evName);
+    void handleEvent_(const Event& ev, CorrelationId corrId, const char* evName);
 
 private:
     EventBus& bus_;
     mutable std::mutex mx_;
-    std::unordered_map<std::string, Timeline> tlByCorr_;
+    std::unordered_map<CorrelationId, Timeline, CorrelationIdHash> tlByCorr_;
 };
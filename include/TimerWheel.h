@@ -0,0 +1,228 @@
+// Hierarchisches Timer-Rad für PLCMonitor::postDelayed.
+// - Zeitbasis: Ticks zu 1 ms (vom Aufrufer geliefert, monoton steigend).
+// - 4 Ebenen à 64 Slots: Ebene L deckt Abstände < 64^(L+1) ms ab (Ebene 3: ~4,6 h);
+//   weiter entfernte Timer parken im letzten Slot von Ebene 3 und werden beim
+//   Kaskadieren neu einsortiert.
+// - Einfügen/Abbrechen O(1) (intrusive Listen über Indizes in einem Slab), Ablauf
+//   O(fällige Timer) plus ein Kaskadenschritt je 64^L Ticks; leere Abschnitte werden
+//   übersprungen. Gleich fällige Timer laufen in Einfügereihenfolge.
+// - Handles (Index + Generation) bleiben nach Ablauf/Abbruch ungültig, auch wenn der
+//   Slab-Eintrag wiederverwendet wird.
+// - Optionaler onDrop-Callback je Timer: clear() gibt ihn für verworfene Timer zurück
+//   (z. B. damit Continuations beim Disconnect abschließen können); cancel() und Ablauf
+//   verwerfen ihn.
+// Nicht thread-sicher; PLCMonitor schützt das Rad mit tmx_.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+class TimerWheel {
+public:
+    using Fn     = std::function<void()>;
+    using Handle = std::uint64_t;               // 0 = ungültig
+    using Tick   = std::uint64_t;
+
+    static constexpr unsigned kBits   = 6;
+    static constexpr unsigned kSlots  = 1u << kBits;   // 64
+    static constexpr unsigned kLevels = 4;
+
+    explicit TimerWheel(Tick start = 0) : cur_(start) {
+        for (auto& lvl : heads_) lvl.fill(kNil);
+        for (auto& lvl : tails_) lvl.fill(kNil);
+    }
+
+    // fn läuft beim ersten advance(now) mit now >= due (frühestens im nächsten Tick)
+    Handle schedule(Tick due, Fn fn, Fn onDrop = {}) {
+        if (due <= cur_) due = cur_ + 1;
+        const std::uint32_t i = alloc_();
+        Node& n = nodes_[i];
+        n.due    = due;
+        n.seq    = seq_++;
+        n.fn     = std::move(fn);
+        n.onDrop = std::move(onDrop);
+        place_(i);
+        ++count_;
+        return (static_cast<Handle>(n.gen) << 32) | (i + 1);
+    }
+
+    // true, wenn der Timer noch ausstand und entfernt wurde
+    bool cancel(Handle h) {
+        const std::uint32_t low = static_cast<std::uint32_t>(h & 0xFFFFFFFFu);
+        if (low == 0 || low > nodes_.size()) return false;
+        const std::uint32_t i = low - 1;
+        Node& n = nodes_[i];
+        if (!n.active || n.gen != static_cast<std::uint32_t>(h >> 32)) return false;
+        unlink_(i);
+        release_(i);
+        --count_;
+        return true;
+    }
+
+    // Rad bis now vorrücken; fällige Callbacks in Fälligkeitsreihenfolge nach out
+    void advance(Tick now, std::vector<Fn>& out) {
+        if (count_ == 0) { if (now > cur_) cur_ = now; return; }
+        while (cur_ < now && count_ > 0) {
+            if (!occ_[0]) {
+                // Ebenen 0..L-1 leer: bis kurz vor die nächste Kaskade von Ebene L springen
+                unsigned L = 1;
+                while (L + 1 < kLevels && !occ_[L]) ++L;
+                const Tick boundary = ((cur_ >> (kBits * L)) + 1) << (kBits * L);
+                if (boundary - 1 > cur_) cur_ = (std::min)(now, boundary - 1);
+                if (cur_ >= now) break;
+            }
+            ++cur_;
+            // höhere Ebenen zuerst, damit herabfallende Timer im selben Tick weiterwandern
+            for (unsigned L = kLevels - 1; L >= 1; --L) {
+                if ((cur_ & mask_(L)) == 0) cascade_(L, static_cast<unsigned>((cur_ >> (kBits * L)) & (kSlots - 1)));
+            }
+            // Slot-Listen sind nur je Einfügeweg FIFO (direkt vs. kaskadiert) -> nach seq ordnen
+            const size_t first = out.size();
+            for (std::uint32_t i = heads_[0][cur_ & (kSlots - 1)]; i != kNil; i = nodes_[i].next)
+                fired_.push_back(i);
+            if (fired_.size() > 1)
+                std::sort(fired_.begin(), fired_.end(),
+                          [&](std::uint32_t a, std::uint32_t b){ return nodes_[a].seq < nodes_[b].seq; });
+            for (const std::uint32_t i : fired_) {
+                unlink_(i);
+                out.push_back(std::move(nodes_[i].fn));
+                release_(i);
+            }
+            count_ -= out.size() - first;
+            fired_.clear();
+        }
+        if (count_ == 0 && now > cur_) cur_ = now;
+    }
+
+    // Frühester Tick, zu dem advance() etwas tun muss: exakt für Timer < 64 ms, sonst der
+    // Kaskadenzeitpunkt ihres Slots (untere Schranke). nullopt, wenn nichts aussteht.
+    std::optional<Tick> nextDue() const {
+        if (count_ == 0) return std::nullopt;
+        std::optional<Tick> best;
+        for (unsigned L = 0; L < kLevels; ++L) {
+            if (!occ_[L]) continue;
+            const unsigned shift = kBits * L;
+            const Tick     block = cur_ >> shift;
+            // erster belegter Slot nach dem aktuellen Block (zyklisch)
+            const unsigned from = static_cast<unsigned>((block + 1) & (kSlots - 1));
+            const unsigned k    = static_cast<unsigned>(std::countr_zero(std::rotr(occ_[L], static_cast<int>(from))));
+            const Tick     t    = (block + 1 + k) << shift;
+            if (!best || t < *best) best = t;
+        }
+        return best;
+    }
+
+    size_t size() const { return count_; }
+    bool   empty() const { return count_ == 0; }
+    Tick   now() const { return cur_; }
+
+    // Alle ausstehenden Timer verwerfen. Die Slab-Einträge gehen über release_() zurück
+    // (Generation steigt), damit alte Handles auch nach dem Leeren ungültig bleiben.
+    // dropped: erhält die onDrop-Callbacks der verworfenen Timer (in Einfügereihenfolge).
+    void clear(std::vector<Fn>* dropped = nullptr) {
+        if (dropped) {
+            for (std::uint32_t i = 0; i < nodes_.size(); ++i)
+                if (nodes_[i].active && nodes_[i].onDrop) fired_.push_back(i);
+            std::sort(fired_.begin(), fired_.end(),
+                      [&](std::uint32_t a, std::uint32_t b){ return nodes_[a].seq < nodes_[b].seq; });
+            for (const std::uint32_t i : fired_) dropped->push_back(std::move(nodes_[i].onDrop));
+            fired_.clear();
+        }
+        for (std::uint32_t i = 0; i < nodes_.size(); ++i)
+            if (nodes_[i].active) release_(i);
+        count_ = 0;
+        for (auto& lvl : heads_) lvl.fill(kNil);
+        for (auto& lvl : tails_) lvl.fill(kNil);
+        for (auto& o : occ_) o = 0;
+    }
+
+private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+
+    struct Node {
+        Tick          due{0};
+        std::uint64_t seq{0};                   // Einfügereihenfolge
+        Fn            fn;
+        Fn            onDrop;                   // nur bei clear() zurückgegeben
+        std::uint32_t prev{kNil}, next{kNil};
+        std::uint32_t gen{0};
+        std::uint8_t  level{0}, slot{0};
+        bool          active{false};
+    };
+
+    static constexpr Tick mask_(unsigned L) { return (Tick{1} << (kBits * L)) - 1; }
+
+    std::uint32_t alloc_() {
+        if (free_ != kNil) {
+            const std::uint32_t i = free_;
+            free_ = nodes_[i].next;
+            nodes_[i].active = true;
+            return i;
+        }
+        nodes_.emplace_back();
+        nodes_.back().active = true;
+        return static_cast<std::uint32_t>(nodes_.size() - 1);
+    }
+    void release_(std::uint32_t i) {
+        Node& n = nodes_[i];
+        n.fn     = nullptr;
+        n.onDrop = nullptr;
+        n.active = false;
+        ++n.gen;
+        n.next   = free_;
+        free_    = i;
+    }
+
+    // Ebene nach Abstand zu cur_; zu weit entfernte Timer in den letzten Slot von Ebene 3
+    void place_(std::uint32_t i) {
+        Node& n = nodes_[i];
+        const Tick delta = n.due - cur_;
+        unsigned L = 0;
+        while (L + 1 < kLevels && delta >= (Tick{1} << (kBits * (L + 1)))) ++L;
+        const Tick at = (delta >> (kBits * kLevels)) ? cur_ + (Tick{1} << (kBits * kLevels)) - 1 : n.due;
+        const unsigned s = static_cast<unsigned>((at >> (kBits * L)) & (kSlots - 1));
+
+        n.level = static_cast<std::uint8_t>(L);
+        n.slot  = static_cast<std::uint8_t>(s);
+        n.next  = kNil;
+        n.prev  = tails_[L][s];
+        if (n.prev != kNil) nodes_[n.prev].next = i;
+        else                heads_[L][s] = i;
+        tails_[L][s] = i;
+        occ_[L] |= (std::uint64_t{1} << s);
+    }
+    void unlink_(std::uint32_t i) {
+        Node& n = nodes_[i];
+        if (n.prev != kNil) nodes_[n.prev].next = n.next;
+        else                heads_[n.level][n.slot] = n.next;
+        if (n.next != kNil) nodes_[n.next].prev = n.prev;
+        else                tails_[n.level][n.slot] = n.prev;
+        if (heads_[n.level][n.slot] == kNil) occ_[n.level] &= ~(std::uint64_t{1} << n.slot);
+        n.prev = n.next = kNil;
+    }
+    // Slot s von Ebene L relativ zu cur_ neu einsortieren (landet auf tieferen Ebenen)
+    void cascade_(unsigned L, unsigned s) {
+        std::uint32_t i = heads_[L][s];
+        heads_[L][s] = kNil;
+        tails_[L][s] = kNil;
+        occ_[L] &= ~(std::uint64_t{1} << s);
+        while (i != kNil) {
+            const std::uint32_t next = nodes_[i].next;
+            place_(i);
+            i = next;
+        }
+    }
+
+    Tick                       cur_{0};      // letzter abgearbeiteter Tick
+    std::uint64_t              seq_{0};
+    size_t                     count_{0};
+    std::vector<Node>          nodes_;
+    std::uint32_t              free_{kNil};
+    std::vector<std::uint32_t> fired_;       // Puffer für advance()
+    std::array<std::array<std::uint32_t, kSlots>, kLevels> heads_{}, tails_{};   // FIFO je Slot
+    std::array<std::uint64_t, kLevels>                     occ_{};   // Bit je belegtem Slot
+};
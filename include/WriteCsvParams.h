@@ -19,8 +19,9 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "Correlation.h"
 struct CsvRow {
-  std::string corrId;
+  CorrelationId corrId;        // Text erst beim Schreiben (str())
   std::string eventType;
   long long   durationMs{0};
   long long   durSumMs{0};
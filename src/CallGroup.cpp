@@ -0,0 +1,87 @@
+// CallGroup.cpp
+// Ausführung von CallMethod-Gruppen über PLCMonitor: Einzelschritte per callMethodTyped,
+// mehrere Calls einer Schrittgruppe gebündelt per callMethodsTyped (ein Roundtrip);
+// executeCallGroupAsync schickt die Gruppe per callMethodsAsync und meldet per Callback.
+#include "CallGroup.h"
+#include "PLCMonitor.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+std::vector<CallStepResult> executeCallGroup(PLCMonitor& mon,
+                                             const std::vector<Operation>& ops,
+                                             size_t b, size_t e,
+                                             unsigned defaultTimeoutMs)
+{
+    std::vector<CallStepResult> out(e > b ? e - b : 0);
+    if (out.empty()) return out;
+
+    auto timeoutOf = [&](const Operation& op) {
+        return (op.timeoutMs > 0) ? static_cast<unsigned>(op.timeoutMs) : defaultTimeoutMs;
+    };
+
+    std::vector<size_t> calls;   // Index in ops der CallMethod-Schritte
+    for (size_t i = b; i < e; ++i)
+        if (ops[i].type == OpType::CallMethod) calls.push_back(i);
+    if (calls.empty()) return out;
+
+    if (calls.size() == 1) {
+        const Operation& op = ops[calls[0]];
+        CallStepResult& r = out[calls[0] - b];
+        r.callOk = mon.callMethodTyped(op.callObjNodeId, op.callMethNodeId, op.inputs, r.got, timeoutOf(op));
+        return out;
+    }
+
+    std::vector<PLCMonitor::CallSpec> specs;
+    specs.reserve(calls.size());
+    unsigned to = 0;
+    for (const size_t i : calls) {
+        specs.push_back(PLCMonitor::CallSpec{ ops[i].callObjNodeId, ops[i].callMethNodeId, ops[i].inputs });
+        to = (std::max)(to, timeoutOf(ops[i]));
+    }
+    std::cout << "[CallGroup] steps#" << b << ".." << (e - 1) << " -> one CallRequest ("
+              << specs.size() << " methods, timeout=" << to << "ms)\n";
+
+    std::vector<PLCMonitor::CallResult> res;
+    (void)mon.callMethodsTyped(specs, res, to);
+    for (size_t k = 0; k < calls.size() && k < res.size(); ++k) {
+        CallStepResult& r = out[calls[k] - b];
+        r.callOk = (res[k].status == UA_STATUSCODE_GOOD);
+        r.got    = std::move(res[k].outputs);
+    }
+    return out;
+}
+
+void executeCallGroupAsync(PLCMonitor& mon,
+                           const std::vector<Operation>& ops,
+                           size_t b, size_t e,
+                           unsigned defaultTimeoutMs,
+                           std::function<void(std::vector<CallStepResult>)> done)
+{
+    const size_t n = (e > b) ? e - b : 0;
+    std::vector<size_t> calls;   // Index in ops der CallMethod-Schritte
+    std::vector<PLCMonitor::CallSpec> specs;
+    unsigned to = 0;
+    for (size_t i = b; i < e; ++i) {
+        const Operation& op = ops[i];
+        if (op.type != OpType::CallMethod) continue;
+        calls.push_back(i);
+        specs.push_back(PLCMonitor::CallSpec{ op.callObjNodeId, op.callMethNodeId, op.inputs });
+        to = (std::max)(to, (op.timeoutMs > 0) ? static_cast<unsigned>(op.timeoutMs) : defaultTimeoutMs);
+    }
+    if (calls.empty()) { done(std::vector<CallStepResult>(n)); return; }
+    if (calls.size() > 1)
+        std::cout << "[CallGroup] steps#" << b << ".." << (e - 1) << " -> one CallRequest ("
+                  << specs.size() << " methods, timeout=" << to << "ms, async)\n";
+
+    mon.callMethodsAsync(std::move(specs), to,
+        [b, n, calls = std::move(calls), done = std::move(done)](std::vector<PLCMonitor::CallResult> res) {
+            std::vector<CallStepResult> out(n);
+            for (size_t k = 0; k < calls.size() && k < res.size(); ++k) {
+                CallStepResult& r = out[calls[k] - b];
+                r.callOk = (res[k].status == UA_STATUSCODE_GOOD);
+                r.got    = std::move(res[k].outputs);
+            }
+            done(std::move(out));
+        });
+}
@@ -2,10 +2,24 @@
 // Zentrale Event-Vermittlung im System.
 // Bietet subscribe()/unsubscribe() und verteilt Events asynchron an alle
 // registrierten ReactiveObserver, sortiert nach Priorität und Anmeldereihenfolge.
+// Die Queue ist ein lock-freier Ring (mehrere Producer, ein Konsument); verteilt wird
+// entweder per process() aus dem Main-Loop oder von einem eigenen Dispatch-Thread.
 
 #include "EventBus.h"
-#include <algorithm> // sort, remove_if
+#include <algorithm> // find_if, none_of
+#include <iostream>
 
+EventBus::EventBus(size_t ringCapacity) {
+    size_t cap = 2;
+    while (cap < ringCapacity) cap <<= 1;
+    ring_ = std::make_unique<Cell[]>(cap);
+    for (size_t i = 0; i < cap; ++i) ring_[i].seq.store(i, std::memory_order_relaxed);
+    mask_ = cap - 1;
+}
+
+EventBus::~EventBus() {
+    stopDispatchThread();
+}
 
 // Einen Observer für einen EventType registrieren.
 // priority: höhere Werte werden zuerst bedient (4 > 3 > 2 > 1).
@@ -21,29 +35,50 @@ SubscriptionToken EventBus::subscribe(EventType t,
 
     std::lock_guard<std::mutex> lk(mx_);
     const auto id = nextId_.fetch_add(1, std::memory_order_relaxed);
-    listeners_[t].push_back(Entry{ std::weak_ptr<ReactiveObserver>(obs), id, priority });
+    Entry e{ std::weak_ptr<ReactiveObserver>(obs), id, priority };
+
+    // Kopie + sortiert einfügen: zuerst höhere Priorität, dann ältere Subscription.
+    // Neue id ist die größte -> hinter alle Einträge gleicher oder höherer Priorität.
+    auto cur  = listeners(t);
+    auto next = cur ? std::make_shared<ListenerList>(*cur) : std::make_shared<ListenerList>();
+    auto pos  = std::find_if(next->begin(), next->end(),
+                             [&](const Entry& x){ return x.priority < priority; });
+    next->insert(pos, std::move(e));
+    listeners_[slot(t)].store(std::move(next), std::memory_order_release);
+
     tok = SubscriptionToken{ t, id };
     return tok;
-} 
+}
 
 // Eine bestehende Subscription wieder abmelden.
 void EventBus::unsubscribe(const SubscriptionToken& tok) {
     if (!tok) return;
     std::lock_guard<std::mutex> lk(mx_);
-    auto it = listeners_.find(tok.type);
-    if (it == listeners_.end()) return;
+    auto cur = listeners(tok.type);
+    if (!cur) return;
+    if (std::none_of(cur->begin(), cur->end(),
+                     [&](const Entry& e){ return e.id == tok.id; })) return;
 
-    auto& vec = it->second;
-    vec.erase(std::remove_if(vec.begin(), vec.end(),
-              [&](const Entry& e){ return e.id == tok.id; }),
-              vec.end());
+    auto next = std::make_shared<ListenerList>();
+    next->reserve(cur->size() - 1);
+    for (const auto& e : *cur) if (e.id != tok.id) next->push_back(e);
+    listeners_[slot(tok.type)].store(std::move(next), std::memory_order_release);
 }
 // Ein Event posten (Thread-sicher).
-// Die Events landen in einer Queue und werden später über process()/dispatch_one()
-// verarbeitet.
+// Die Events landen im Ring und werden später über process()/dispatch_one() bzw. den
+// Dispatch-Thread verarbeitet. Solange der Überlauf nicht leer ist, geht alles dorthin
+// (sonst könnte ein späteres Event eines Producers ein früheres überholen).
 void EventBus::post(Event ev) {
-    std::lock_guard<std::mutex> lk(mx_);
-    q_.push_back(std::move(ev));
+    bool queued = false;
+    if (overflowCount_.load(std::memory_order_acquire) == 0)
+        queued = ring_push(ev);
+    if (!queued) {
+        std::lock_guard<std::mutex> lk(ovmx_);
+        overflow_.push_back(std::move(ev));
+        overflowCount_.fetch_add(1, std::memory_order_release);
+    }
+    wake_dispatcher();
+    if (wakeHook_ && !dispatching_.load(std::memory_order_acquire)) wakeHook_();
 }
 
 void EventBus::post_now(const Event& ev) {
@@ -52,44 +87,143 @@ void EventBus::post_now(const Event& ev) {
 // Verarbeite bis zu maxEvents Events aus der Queue.
 // Das ist die "Pump"-Funktion, die im Main-Loop regelmäßig aufgerufen wird.
 void EventBus::process(size_t maxEvents) {
+    if (dispatching_.load(std::memory_order_acquire)) return; // Dispatch-Thread ist zuständig
     // Schleife: ziehe Events aus der Queue, bis entweder die Queue leer ist
     // oder maxEvents erreicht wurden.
     for (size_t i = 0; i < maxEvents; ++i) {
         Event ev;
-        {
-            std::lock_guard<std::mutex> lk(mx_);
-            if (q_.empty()) break;
-            ev = std::move(q_.front());
-            q_.pop_front();
-        }
+        if (!pop_next(ev)) break;
         dispatch_one(ev);
     }
 }
 
 void EventBus::clear_queue() {
-    std::lock_guard<std::mutex> lk(mx_);
-    q_.clear();
+    Event ev;
+    while (pop_next(ev)) {}
 }
 
-void EventBus::dispatch_one(const Event& ev) {
-    // Schnappschuss der Listener (Lock kurz halten)
-    std::vector<Entry> copy;
-    {
-        std::lock_guard<std::mutex> lk(mx_);
-        auto it = listeners_.find(ev.type);
-        if (it == listeners_.end()) return;
-        copy = it->second;
+// ---------- Ring ----------
+bool EventBus::ring_push(Event& ev) {
+    size_t pos = enqPos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& c = ring_[pos & mask_];
+        const size_t seq = c.seq.load(std::memory_order_acquire);
+        const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+        if (dif == 0) {
+            if (enqPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                c.ev = std::move(ev);
+                c.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (dif < 0) {
+            return false;                               // Ring voll
+        } else {
+            pos = enqPos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool EventBus::ring_pop(Event& out) {
+    size_t pos = deqPos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& c = ring_[pos & mask_];
+        const size_t seq = c.seq.load(std::memory_order_acquire);
+        const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+        if (dif == 0) {
+            // CAS statt Store: clear_queue() darf parallel zum Dispatch-Thread laufen
+            if (deqPos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                out  = std::move(c.ev);
+                c.ev = Event{};                         // Payload sofort freigeben
+                c.seq.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (dif < 0) {
+            return false;                               // Ring leer
+        } else {
+            pos = deqPos_.load(std::memory_order_relaxed);
+        }
     }
+}
 
-    // Sortierung: zuerst höhere Priorität, dann ältere Subscription (stabil)
-    std::sort(copy.begin(), copy.end(),
-        [](const Entry& a, const Entry& b){
-            if (a.priority != b.priority) return a.priority > b.priority; // 4 > 3 > 2 > 1
-            return a.id < b.id; // ältere zuerst
-        });
+bool EventBus::ring_empty() const {
+    const size_t pos = deqPos_.load(std::memory_order_acquire);
+    return ring_[pos & mask_].seq.load(std::memory_order_acquire) != pos + 1;
+}
+
+bool EventBus::pop_next(Event& out) {
+    if (ring_pop(out)) return true;
+    if (overflowCount_.load(std::memory_order_acquire) == 0) return false;
+    std::lock_guard<std::mutex> lk(ovmx_);
+    if (overflow_.empty()) return false;
+    out = std::move(overflow_.front());
+    overflow_.pop_front();
+    overflowCount_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool EventBus::has_pending() const {
+    return !ring_empty() || overflowCount_.load(std::memory_order_acquire) != 0;
+}
+
+// ---------- Dispatch-Thread ----------
+// Producer: Event einreihen -> Fence -> sleeping_ lesen. Dispatcher: sleeping_ setzen ->
+// Fence -> Queue prüfen. Damit sieht mindestens eine Seite die andere (kein verlorenes Wake).
+void EventBus::wake_dispatcher() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        wake_.fetch_add(1, std::memory_order_release);
+        wake_.notify_one();
+    }
+}
+
+bool EventBus::startDispatchThread() {
+    if (dispatching_.exchange(true, std::memory_order_acq_rel)) return true;
+    dispatcher_ = std::jthread([this](std::stop_token st){ dispatch_loop(st); });
+    return true;
+}
+
+void EventBus::stopDispatchThread() {
+    if (!dispatcher_.joinable()) return;
+    dispatcher_.request_stop();
+    wake_.fetch_add(1, std::memory_order_release);
+    wake_.notify_one();
+    dispatcher_.join();
+    dispatching_.store(false, std::memory_order_release);
+}
+
+void EventBus::dispatch_loop(std::stop_token st) {
+    for (;;) {
+        Event ev;
+        if (pop_next(ev)) {
+            try {
+                dispatch_one(ev);
+            } catch (const std::exception& e) {
+                std::cerr << "[EventBus] observer threw: " << e.what() << "\n";
+            } catch (...) {
+                std::cerr << "[EventBus] observer threw (unknown)\n";
+            }
+            continue;
+        }
+        if (st.stop_requested()) break;                 // Queue leer + Stop -> fertig
+
+        const auto w = wake_.load(std::memory_order_acquire);
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_pending() && !st.stop_requested())
+            wake_.wait(w, std::memory_order_acquire);
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+}
+
+void EventBus::dispatch_one(const Event& ev) {
+    if (slot(ev.type) >= kEventTypeCount) return;
+    // Schnappschuss der Listener: nur Zeiger laden, Liste ist bereits sortiert
+    // (4 > 3 > 2 > 1, bei gleicher Priorität ältere Subscription zuerst)
+    const ListenerPtr list = listeners(ev.type);
+    if (!list) return;
 
     bool anyDead = false;
-    for (const auto& e : copy) {
+    for (const auto& e : *list) {
         if (auto sp = e.wp.lock()) {
             sp->onEvent(ev);
         } else {
@@ -101,12 +235,12 @@ void EventBus::dispatch_one(const Event& ev) {
 
 void EventBus::sweep_dead(EventType t) {
     std::lock_guard<std::mutex> lk(mx_);
-    auto it = listeners_.find(t);
-    if (it == listeners_.end()) return;
-    auto& vec = it->second;
-    vec.erase(std::remove_if(vec.begin(), vec.end(),
-             [](const Entry& e){ return e.wp.expired(); }),
-             vec.end());
+    auto cur = listeners(t);
+    if (!cur) return;
+    auto next = std::make_shared<ListenerList>();
+    next->reserve(cur->size());
+    for (const auto& e : *cur) if (!e.wp.expired()) next->push_back(e);
+    listeners_[slot(t)].store(std::move(next), std::memory_order_release);
 }
 
 // -------- Subscription (RAII) ----------
@@ -1,6 +1,6 @@
 // FailureRecorder.cpp
 // Komponente, die für jede correlationId Failure-bezogene Informationen sammelt,
-// Snapshots in JSON konvertiert, Failure Modes, Monitoring Actions und System Reactions
+// Snapshots (geteilt, unverändert) vorhält, Failure Modes, Monitoring Actions und System Reactions
 // mitschreibt und daraus später die KG-Ingestion-Parameter aufbaut.
 
 #include "FailureRecorder.h"
@@ -28,15 +28,15 @@ void FailureRecorder::subscribeAll() {
     bus_.subscribe(EventType::evGotFM,            self, 3);
 }
 
-void FailureRecorder::resetCorrUnlocked(const std::string& corr) {
-    snapshotJsonByCorr_.erase(corr);
+void FailureRecorder::resetCorrUnlocked(CorrelationId corr) {
+    snapshotByCorr_.erase(corr);
     monReactsByCorr_.erase(corr);
     sysReactsByCorr_.erase(corr);
     failureModeByCorr_.erase(corr);
     ingestionStarted_.erase(corr);
 }
 
-bool FailureRecorder::tryMarkIngestion(const std::string& corr) {
+bool FailureRecorder::tryMarkIngestion(CorrelationId corr) {
     std::lock_guard<std::mutex> lk(mx_);
     auto [it, inserted] = ingestionStarted_.insert(corr);
     return inserted; // true = first time, false = already triggered
@@ -55,38 +55,6 @@ std::string FailureRecorder::now_ts() {
     std::ostringstream oss; oss << std::put_time(&tm, "%Y-%m-%d_%H-%M-%S");
     return oss.str();
 }
-std::string FailureRecorder::wrapSnapshot(const std::string& js) {
-    return "==InventorySnapshot==" + js + "==InventorySnapshot==";
-}
-std::string FailureRecorder::findStringInSnap(const json& snap, const char* nodeId) {
-    if (!snap.contains("vars") || !snap["vars"].is_array()) return {};
-    for (const auto& e : snap["vars"]) {
-        if (e.is_object()
-            && e.contains("id") && e["id"].is_string()
-            && e["id"].get<std::string>() == nodeId
-            && e.contains("t") && e.contains("v")
-            && e["t"].is_string() && e["t"].get<std::string>() == "string"
-            && e["v"].is_string())
-            return e["v"].get<std::string>();
-    }
-    return {};
-}
-FailureRecorder::json FailureRecorder::snapshotToJson_flat(const InventorySnapshot& inv) {
-    auto add = [](json& arr, const std::string& id, const char* t, const json& v) {
-        arr.push_back(json{{"id",id},{"t",t},{"v",v}});
-    };
-    json out;
-    out["rows"] = json::array();
-    for (const auto& r : inv.rows)
-        out["rows"].push_back({{"id",r.nodeId},{"t",r.dtypeOrSig},{"nodeClass",r.nodeClass}});
-    out["vars"] = json::array();
-    for (const auto& [k,v] : inv.bools)   add(out["vars"], k.id, "bool",   v);
-    for (const auto& [k,v] : inv.strings) add(out["vars"], k.id, "string", v);
-    for (const auto& [k,v] : inv.int16s)  add(out["vars"], k.id, "int16",  v);
-    for (const auto& [k,v] : inv.floats)  add(out["vars"], k.id, "float",  v);
-    return out;
-}
-
 // (legacy helper; falls anderswo gebraucht)
 FailureRecorder::json FailureRecorder::snapshotToJson(const InventorySnapshot& inv) {
     auto keyToJ = [](const NodeKey& k){
@@ -94,7 +62,7 @@ FailureRecorder::json FailureRecorder::snapshotToJson(const InventorySnapshot& i
     };
     json j;
     j["rows"] = json::array();
-    for (const auto& r : inv.rows) {
+    for (const auto& r : inv.rowList()) {
         j["rows"].push_back({
             {"nodeClass", r.nodeClass},
             {"id",        r.nodeId},
@@ -102,19 +70,19 @@ FailureRecorder::json FailureRecorder::snapshotToJson(const InventorySnapshot& i
         });
     }
     j["bools"]   = json::array();
-    for (const auto& [k,v] : inv.bools)   j["bools"].push_back(  {{"k",keyToJ(k)},{"v",v}} );
+    inv.forEach(VarKind::Bool,   [&](const NodeKey& k, uint32_t s){ j["bools"].push_back(  {{"k",keyToJ(k)},{"v",inv.colBool[s] != 0}} ); });
     j["strings"] = json::array();
-    for (const auto& [k,v] : inv.strings) j["strings"].push_back({{"k",keyToJ(k)},{"v",v}} );
+    inv.forEach(VarKind::String, [&](const NodeKey& k, uint32_t s){ j["strings"].push_back({{"k",keyToJ(k)},{"v",inv.colStr[s]}} ); });
     j["int16s"]  = json::array();
-    for (const auto& [k,v] : inv.int16s)  j["int16s"].push_back( {{"k",keyToJ(k)},{"v",v}} );
+    inv.forEach(VarKind::Int16,  [&](const NodeKey& k, uint32_t s){ j["int16s"].push_back( {{"k",keyToJ(k)},{"v",inv.colI16[s]}} ); });
     j["floats"]  = json::array();
-    for (const auto& [k,v] : inv.floats)  j["floats"].push_back( {{"k",keyToJ(k)},{"v",v}} );
+    inv.forEach(VarKind::Float,  [&](const NodeKey& k, uint32_t s){ j["floats"].push_back( {{"k",keyToJ(k)},{"v",inv.colF64[s]}} ); });
     return j;
 }
 
 // baut ein fertiges Param-Objekt (holt Snapshot + lastSkill/lastProcess + Reaktions-IRIs)
 std::shared_ptr<KgIngestionParams>
-FailureRecorder::buildParams(const std::string& corr, const std::string& process, const std::string& summary)
+FailureRecorder::buildParams(CorrelationId corr, const std::string& process, const std::string& summary)
 {
     KgIngestionParams prm;
     prm.corr       = corr;
@@ -122,13 +90,12 @@ FailureRecorder::buildParams(const std::string& corr, const std::string& process
     prm.summary    = summary;
     prm.resourceId = "KG";
     prm.ts         = now_ts();
-    prm.individualName = prm.corr + "_" + prm.ts;
+    prm.individualName = prm.corr.str() + "_" + prm.ts;   // Textform erst hier (Ingestion)
 
-    std::string snap;
     {
         std::lock_guard<std::mutex> lk(mx_);
-        if (auto it = snapshotJsonByCorr_.find(corr); it != snapshotJsonByCorr_.end())
-            snap = it->second;
+        if (auto it = snapshotByCorr_.find(corr); it != snapshotByCorr_.end())
+            prm.snapshot = it->second;
 
         // NEW: ExecmonReactions (vector) & ExecsysReaction (string)
         if (auto it = monReactsByCorr_.find(corr); it != monReactsByCorr_.end())
@@ -145,12 +112,12 @@ FailureRecorder::buildParams(const std::string& corr, const std::string& process
             prm.failureMode = it->second;
     }
 
-    prm.snapshotWrapped = wrapSnapshot(snap);
-    try {
-        json j = snap.empty() ? json::object() : json::parse(snap);
-        prm.lastSkill   = findStringInSnap(j, "OPCUA.lastExecutedSkill");
-        prm.lastProcess = findStringInSnap(j, "OPCUA.lastExecutedProcess");
-    } catch (...) {}
+    // lastSkill/lastProcess direkt aus dem typisierten Snapshot; das JSON baut erst
+    // KgIngestionForce im PythonWorker (KgIngestionParams::materializeSnapshot)
+    if (prm.snapshot) {
+        if (auto v = prm.snapshot->findString(NodeKey{4, 's', "OPCUA.lastExecutedSkill"}))   prm.lastSkill   = *v;
+        if (auto v = prm.snapshot->findString(NodeKey{4, 's', "OPCUA.lastExecutedProcess"})) prm.lastProcess = *v;
+    }
 
     return std::make_shared<KgIngestionParams>(std::move(prm));
 }
@@ -161,10 +128,10 @@ void FailureRecorder::startIngestionWith(std::shared_ptr<KgIngestionParams> prm)
     Operation op; op.type = OpType::KGIngestion;
     op.attach = prm; // getyptes Cargo bevorzugt
     // Fallback für (ältere) Implementierungen:
-    op.inputs[0] = prm->corr;
+    op.inputs[0] = prm->corr.str();
     op.inputs[1] = prm->process;
     op.inputs[2] = prm->summary;
-    op.inputs[3] = prm->snapshotWrapped;
+    // inputs[3] (Snapshot-JSON) entfällt: wird erst bei der Ingestion aus prm->snapshot gebaut
     p.ops.push_back(std::move(op));
 
     if (auto cf = CommandForceFactory::createForOp(p.ops.front(), /*mon*/nullptr, bus_))
@@ -174,41 +141,21 @@ void FailureRecorder::startIngestionWith(std::shared_ptr<KgIngestionParams> prm)
 // ---------- zentrales Event-Handling ----------
 void FailureRecorder::onEvent(const Event& ev) {
     switch (ev.type) {
-        case EventType::evD2: {
-            if (auto p = std::any_cast<D2Snapshot>(&ev.payload)) {
-                const std::string corr = p->correlationId;
-                const std::string js   = snapshotToJson_flat(p->inv).dump();
-                std::lock_guard<std::mutex> lk(mx_);
-                resetCorrUnlocked(corr);            // <- ALT-STATE sicher löschen
-                activeCorr_.insert(corr);           // <- Session aktivieren
-                snapshotJsonByCorr_[corr] = js;     // <- frischer Snapshot
-            }
-            break;
-        }
-        case EventType::evD1: {
-            if (auto p = std::any_cast<D2Snapshot>(&ev.payload)) {
-                const std::string corr = p->correlationId;
-                const std::string js   = snapshotToJson_flat(p->inv).dump();
-                std::lock_guard<std::mutex> lk(mx_);
-                resetCorrUnlocked(corr);            // <- ALT-STATE sicher löschen
-                activeCorr_.insert(corr);           // <- Session aktivieren
-                snapshotJsonByCorr_[corr] = js;     // <- frischer Snapshot
-            }
-            break;
-        }
+        case EventType::evD2:
+        case EventType::evD1:
         case EventType::evD3: {
-            if (auto p = std::any_cast<D2Snapshot>(&ev.payload)) {
-                const std::string corr = p->correlationId;
-                const std::string js   = snapshotToJson_flat(p->inv).dump();
+            // Nur den geteilten Snapshot merken – keine Serialisierung auf dem Bus-Thread
+            if (auto p = std::get_if<D2Snapshot>(&ev.payload); p && p->inv) {
+                const CorrelationId corr = p->correlationId;
                 std::lock_guard<std::mutex> lk(mx_);
                 resetCorrUnlocked(corr);            // <- ALT-STATE sicher löschen
                 activeCorr_.insert(corr);           // <- Session aktivieren
-                snapshotJsonByCorr_[corr] = js;     // <- frischer Snapshot
+                snapshotByCorr_[corr] = p->inv;     // <- frischer Snapshot (nur Referenz)
             }
             break;
         }
         case EventType::evGotFM: {
-            if (auto a = std::any_cast<GotFMAck>(&ev.payload)) {
+            if (auto a = std::get_if<GotFMAck>(&ev.payload)) {
                 std::lock_guard<std::mutex> lk(mx_);
                 if (!activeCorr_.count(a->correlationId)) break;
                 if (ingestionStarted_.count(a->correlationId)) break;
@@ -217,7 +164,7 @@ void FailureRecorder::onEvent(const Event& ev) {
             break;
         }
         case EventType::evMonActFinished: {
-            if (auto a = std::any_cast<MonActFinishedAck>(&ev.payload)) {
+            if (auto a = std::get_if<MonActFinishedAck>(&ev.payload)) {
                 std::lock_guard<std::mutex> lk(mx_);
                 if (!activeCorr_.count(a->correlationId)) break;       // ignorieren, wenn nicht aktiv
                 if (ingestionStarted_.count(a->correlationId)) break;  // ignorieren, wenn schon getriggert
@@ -226,7 +173,7 @@ void FailureRecorder::onEvent(const Event& ev) {
             break;
         }
         case EventType::evSysReactFinished: {
-            if (auto a = std::any_cast<SysReactFinishedAck>(&ev.payload)) {
+            if (auto a = std::get_if<SysReactFinishedAck>(&ev.payload)) {
                 std::lock_guard<std::mutex> lk(mx_);
                 if (!activeCorr_.count(a->correlationId)) break;
                 if (ingestionStarted_.count(a->correlationId)) break;
@@ -236,7 +183,7 @@ void FailureRecorder::onEvent(const Event& ev) {
         }
         // --- Trigger: Ingestion starten ---
         case EventType::evProcessFail: {
-            if (auto a = std::any_cast<ProcessFailAck>(&ev.payload)) {
+            if (auto a = std::get_if<ProcessFailAck>(&ev.payload)) {
                 if (!tryMarkIngestion(a->correlationId)) break; // schon gestartet
                 auto prm = buildParams(a->correlationId, a->processName, a->summary);
                 startIngestionWith(std::move(prm));
@@ -244,7 +191,7 @@ void FailureRecorder::onEvent(const Event& ev) {
             break;
         }
         case EventType::evSRDone: {
-            if (auto d = std::any_cast<ReactionDoneAck>(&ev.payload)) {
+            if (auto d = std::get_if<ReactionDoneAck>(&ev.payload)) {
                 if (!tryMarkIngestion(d->correlationId)) break; // schon gestartet
                 auto prm = buildParams(d->correlationId, "SystemReaction",
                                     std::string("SRDone: ") + (d->rc ? "OK" : "FAIL"));
@@ -255,7 +202,7 @@ void FailureRecorder::onEvent(const Event& ev) {
             break;
         }
         case EventType::evKGTimeout: {
-            if (auto t = std::any_cast<KGTimeoutPayload>(&ev.payload)) {
+            if (auto t = std::get_if<KGTimeoutPayload>(&ev.payload)) {
                 if (!tryMarkIngestion(t->correlationId)) break; // schon gestartet
                 auto prm = buildParams(t->correlationId, "KG", "Knowledge Graph timeout");
                 startIngestionWith(std::move(prm));
@@ -263,7 +210,7 @@ void FailureRecorder::onEvent(const Event& ev) {
             break;
         }
         case EventType::evUnknownFM: {
-            if (auto a = std::any_cast<UnknownFMAck>(&ev.payload)) {
+            if (auto a = std::get_if<UnknownFMAck>(&ev.payload)) {
                 if (!tryMarkIngestion(a->correlationId)) break; // schon gestartet
                 // Prozessname bevorzugt lastExecutedProcess; sonst a->processName
                 auto prm = buildParams(a->correlationId,
@@ -278,7 +225,7 @@ void FailureRecorder::onEvent(const Event& ev) {
 
         // --- Cleanup NUR nach Ingestion ---
         case EventType::evIngestionDone: {
-            if (auto d = std::any_cast<IngestionDoneAck>(&ev.payload)) {
+            if (auto d = std::get_if<IngestionDoneAck>(&ev.payload)) {
                 std::lock_guard<std::mutex> lk(mx_);
                 resetCorrUnlocked(d->correlationId); // <- alles weg
                 activeCorr_.erase(d->correlationId); // <- Session beenden
@@ -4,17 +4,36 @@
 
 #include "InventorySnapShotUtils.h"
 #include <iostream>
+#include <memory>
+#include <mutex>
 
 bool parseNsAndId(const std::string &nodeId, uint16_t &ns, std::string &id, char &typeChar);
 
-// Diese Funktion baut den Snapshot sofort, indem sie alle Variablen unterhalb von root
-// browsed und dann ihre Werte mit den passenden Read-Funktionen einliest.
-bool buildInventorySnapshotNow(PLCMonitor &mon, const std::string &root, InventorySnapshot &s) {
-    s = InventorySnapshot{};
-    mon.dumpPlcInventory(s.rows, root.c_str());
+namespace {
+// Erwarteter Typ je Variable (aus dtypeOrSig), parallel zu den ReadItems geführt.
+struct Wanted {
+    bool isBool, isString, isI16, isF64, isF32;
+};
+
+// Aus dem Inventar abgeleitetes Layout: NodeTable + ReadItem/Typ je Slot.
+// Wird nur bei neuer Inventar-Generation (bzw. anderem root/Monitor) neu berechnet.
+struct SnapshotLayout {
+    const PLCMonitor*                 mon = nullptr;
+    UA_UInt64                         generation = 0;
+    std::string                       root;
+    NodeTablePtr                      nodes;
+    std::vector<PLCMonitor::ReadItem> items;    // items[slot]
+    std::vector<Wanted>               wanted;   // wanted[slot]
+};
+
+std::shared_ptr<SnapshotLayout> buildLayout(const std::vector<InventoryRow>& rows) {
+    auto lay   = std::make_shared<SnapshotLayout>();
+    auto nodes = std::make_shared<NodeTable>();
+    lay->items.reserve(rows.size());
+    lay->wanted.reserve(rows.size());
 
-    // Schleife: iteriert über alle Elemente in s.rows.
-    for (const auto &r : s.rows) {
+    // Schleife: iteriert über alle Zeilen und interniert die lesbaren Variablen.
+    for (const auto &r : rows) {
         if (r.nodeClass != "Variable") continue;
 
         uint16_t ns = 0;
@@ -25,44 +44,97 @@ bool buildInventorySnapshotNow(PLCMonitor &mon, const std::string &root, Invento
         if (type != 's')
             continue;
 
-        bool isBool   = (r.dtypeOrSig.find("Boolean") != std::string::npos);
-        bool isString = (r.dtypeOrSig.find("String")  != std::string::npos) ||
-                        (r.dtypeOrSig.find("STRING")  != std::string::npos);
-        bool isI16    = (r.dtypeOrSig.find("Int16")   != std::string::npos);
-        bool isF64    = (r.dtypeOrSig.find("Double")  != std::string::npos);
-        bool isF32    = (r.dtypeOrSig.find("Float")   != std::string::npos);
-
-        NodeKey k;
-        k.ns   = ns;
-        k.type = 's';
-        k.id   = id;
-
-        if (isBool) {
-            bool v{};
-            if (mon.readBoolAt(id, ns, v))
-                s.bools.emplace(k, v);
-        }
-        if (isString) {
-            std::string v;
-            if (mon.readStringAt(id, ns, v))
-                s.strings.emplace(k, v);
-        }
-        if (isI16) {
-            UA_Int16 v{};
-            if (mon.readInt16At(id, ns, v))
-                s.int16s.emplace(k, static_cast<int16_t>(v));
-        }
-        if (isF64) {
-            UA_Double v{};
-            if (mon.readDoubleAt(id, ns, v))
-                s.floats.emplace(k, static_cast<double>(v));
-        }
-        if (isF32) {
-            UA_Float v{};
-            if (mon.readFloatAt(id, ns, v))
-                s.floats.emplace(k, static_cast<double>(v));
+        Wanted w;
+        w.isBool   = (r.dtypeOrSig.find("Boolean") != std::string::npos);
+        w.isString = (r.dtypeOrSig.find("String")  != std::string::npos) ||
+                     (r.dtypeOrSig.find("STRING")  != std::string::npos);
+        w.isI16    = (r.dtypeOrSig.find("Int16")   != std::string::npos);
+        w.isF64    = (r.dtypeOrSig.find("Double")  != std::string::npos);
+        w.isF32    = (r.dtypeOrSig.find("Float")   != std::string::npos);
+        if (!(w.isBool || w.isString || w.isI16 || w.isF64 || w.isF32))
+            continue;
+
+        const uint32_t slot = nodes->intern(NodeKey{ ns, 's', id });
+        if (slot < lay->items.size()) continue;      // doppelte Zeile
+        lay->items.push_back(PLCMonitor::ReadItem{ ns, id });
+        lay->wanted.push_back(w);
+    }
+    lay->nodes = std::move(nodes);
+    return lay;
+}
+
+std::shared_ptr<const SnapshotLayout> layoutFor(PLCMonitor& mon, const std::string& root,
+                                                const std::vector<InventoryRow>& rows) {
+    static std::mutex mx;
+    static std::shared_ptr<const SnapshotLayout> cached;
+
+    const UA_UInt64 gen = mon.inventoryGeneration();
+    std::lock_guard<std::mutex> lk(mx);
+    if (cached && cached->mon == &mon && cached->generation == gen && cached->root == root)
+        return cached;
+
+    auto lay = buildLayout(rows);
+    lay->mon        = &mon;
+    lay->generation = gen;
+    lay->root       = root;
+    cached = std::move(lay);
+    return cached;
+}
+} // namespace
+
+// Spiegel auf die Slots des aktuellen Snapshot-Layouts: Spiegel-Slot == NodeTable-Slot.
+bool startValueMirrorFor(PLCMonitor &mon, const std::string &root,
+                         double samplingMs, UA_UInt32 queueSize) {
+    InventoryRowsPtr rows;
+    if (!mon.inventoryCached(rows, root.c_str())) return false;
+    return mon.startValueMirror(layoutFor(mon, root, *rows)->nodes, samplingMs, queueSize);
+}
+
+// Diese Funktion baut den Snapshot sofort: Struktur (rows) kommt aus dem Inventory-Cache
+// des PLCMonitor (Browse nur nach Modelländerung). Die Werte stammen bei aktivem Live-Spiegel
+// aus PLCMonitor::mirrorValues (Stand zur Trigger-Flanke edgeSourceTs, keine Reads), sonst
+// bzw. für nicht gespiegelte Knoten aus PLCMonitor::readValuesBatched.
+// Die Slots (NodeTable) werden je Inventarstand einmal vergeben und von allen Snapshots geteilt.
+bool buildInventorySnapshotNow(PLCMonitor &mon, const std::string &root, InventorySnapshot &s,
+                               UA_DateTime edgeSourceTs) {
+    s = InventorySnapshot{};
+    mon.inventoryCached(s.rows, root.c_str());   // geteilt, keine Kopie der Zeilen
+
+    const auto lay = layoutFor(mon, root, s.rowList());
+    const auto& items = lay->items;
+    s.reset(lay->nodes);
+
+    std::vector<UAValue> vals;
+    std::vector<size_t>  missing;
+    bool ok = true;
+    if (mon.mirrorValues(lay->nodes, vals, edgeSourceTs, &missing)) {
+        // nur Knoten ohne Spiegel-Slot bzw. ohne bekannten Wert zur Flanke nachlesen
+        if (!missing.empty()) {
+            std::vector<PLCMonitor::ReadItem> rest;
+            rest.reserve(missing.size());
+            for (size_t idx : missing) rest.push_back(items[idx]);
+            std::vector<UAValue> restVals;
+            ok = mon.readValuesBatched(rest, restVals);
+            for (size_t k = 0; k < missing.size(); ++k)
+                vals[missing[k]] = std::move(restVals[k]);
         }
+    } else {
+        ok = mon.readValuesBatched(items, vals);
+        // Spiegel nach Modelländerung (neue NodeTable) für den nächsten Trigger neu aufsetzen
+        (void)mon.refreshValueMirrorIfStale(lay->nodes);
+    }
+
+    // Schleife: gelesene Werte typgerecht in die Spalten eintragen
+    // (nur wenn der UA-Typ zum erwarteten Datentyp passt, wie bei den Einzel-Reads).
+    for (uint32_t i = 0; i < lay->wanted.size(); ++i) {
+        const auto& w = lay->wanted[i];
+        auto&       v = vals[i];
+        if      (w.isBool   && std::holds_alternative<bool>(v))        s.setBool(i, std::get<bool>(v));
+        else if (w.isString && std::holds_alternative<std::string>(v)) s.setString(i, std::move(std::get<std::string>(v)));
+        else if (w.isI16    && std::holds_alternative<int16_t>(v))     s.setInt16(i, std::get<int16_t>(v));
+        else if (w.isF64    && std::holds_alternative<double>(v))      s.setFloat(i, std::get<double>(v));
+        else if (w.isF32    && std::holds_alternative<float>(v))       s.setFloat(i, static_cast<double>(std::get<float>(v)));
     }
 
-    return true;
+    return ok;
 }
@@ -0,0 +1,520 @@
+// KGIndex.cpp
+// Nativer FMEA-KG-Index: minimaler Turtle-Leser (Teilmenge, wie sie rdflib serialisiert)
+// plus Aufbau der Adjazenz-Indizes Skill -> potFM, FM -> MonAct, FM -> SysReact.
+
+#include "KGIndex.h"
+#include "PlanJsonUtils.h"   // invalidateCompiledPlans
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+using nlohmann::json;
+
+namespace {
+
+const std::string kRdf    = "http://www.w3.org/1999/02/22-rdf-syntax-ns#";
+const std::string kRdfType = kRdf + "type";
+const std::string kCL = std::string(KGIndex::kOntIri) + "class_";
+const std::string kOP = std::string(KGIndex::kOntIri) + "op_";
+const std::string kDP = std::string(KGIndex::kOntIri) + "dp_";
+
+// RDF-Term: IRI, Blank Node ("_:...") oder Literal (nur lexikalischer Wert).
+struct Term {
+    bool        literal = false;
+    std::string value;
+};
+
+// Turtle-Leser für die Teilmenge in src/*.ttl: @prefix/PREFIX, @base, <IRI>, Prefixed
+// Names, "a", Literale ("…", '…', """…""", '''…''' inkl. Escapes, @lang, ^^Typ),
+// Zahlen/Booleans, Blank Nodes (_:x, [ … ]) und Collections ( … ).
+// Collections werden nur überlesen (für die FMEA-Lookups irrelevant).
+class TurtleReader {
+public:
+    using Emit = std::function<void(const Term&, const Term&, const Term&)>;
+
+    TurtleReader(const std::string& src, Emit emit) : s_(src), emit_(std::move(emit)) {}
+
+    void parse() {
+        for (;;) {
+            skipWs();
+            if (eof()) break;
+            if (startsWith("@prefix") || startsWithCi("PREFIX")) { parsePrefix(); continue; }
+            if (startsWith("@base")   || startsWithCi("BASE"))   { parseBase();   continue; }
+            parseTriples();
+        }
+    }
+
+private:
+    const std::string& s_;
+    size_t             p_ = 0;
+    Emit               emit_;
+    std::unordered_map<std::string, std::string> prefixes_;
+    std::string        base_;
+    size_t             bnodes_ = 0;
+
+    bool eof() const { return p_ >= s_.size(); }
+    char peek() const { return eof() ? '\0' : s_[p_]; }
+
+    [[noreturn]] void fail(const std::string& what) const {
+        size_t line = 1;
+        for (size_t i = 0; i < p_ && i < s_.size(); ++i) if (s_[i] == '\n') ++line;
+        throw std::runtime_error("Turtle: " + what + " (Zeile " + std::to_string(line) + ")");
+    }
+
+    bool startsWith(const char* t) const { return s_.compare(p_, std::strlen(t), t) == 0; }
+    bool startsWithCi(const char* t) const {
+        const size_t n = std::strlen(t);
+        if (p_ + n >= s_.size()) return false;
+        for (size_t i = 0; i < n; ++i)
+            if (std::toupper(static_cast<unsigned char>(s_[p_ + i])) != t[i]) return false;
+        return std::isspace(static_cast<unsigned char>(s_[p_ + n])) != 0;
+    }
+
+    void skipWs() {
+        while (!eof()) {
+            const char c = s_[p_];
+            if (c == '#') { while (!eof() && s_[p_] != '\n') ++p_; continue; }
+            if (!std::isspace(static_cast<unsigned char>(c))) break;
+            ++p_;
+        }
+    }
+
+    void expect(char c) {
+        skipWs();
+        if (peek() != c) fail(std::string("'") + c + "' erwartet");
+        ++p_;
+    }
+
+    void parsePrefix() {
+        const bool sparqlStyle = (peek() != '@');
+        p_ += sparqlStyle ? 6 : 7;
+        skipWs();
+        const size_t colon = s_.find(':', p_);
+        if (colon == std::string::npos) fail("Prefix ohne ':'");
+        std::string name = s_.substr(p_, colon - p_);
+        p_ = colon + 1;
+        skipWs();
+        prefixes_[name] = parseIriRef();
+        if (!sparqlStyle) expect('.');
+    }
+
+    void parseBase() {
+        const bool sparqlStyle = (peek() != '@');
+        p_ += sparqlStyle ? 4 : 5;
+        skipWs();
+        base_ = parseIriRef();
+        if (!sparqlStyle) expect('.');
+    }
+
+    std::string parseIriRef() {
+        if (peek() != '<') fail("'<' erwartet");
+        ++p_;
+        std::string out;
+        while (!eof() && s_[p_] != '>') {
+            if (s_[p_] == '\\' && p_ + 1 < s_.size()) { out += unescapeAt(); continue; }
+            out += s_[p_++];
+        }
+        if (eof()) fail("IRI nicht abgeschlossen");
+        ++p_;
+        if (!base_.empty() && out.find(':') == std::string::npos) out = base_ + out;
+        return out;
+    }
+
+    static bool isPnChar(char c) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        return std::isalnum(u) || c == '_' || c == '-' || c == '.' || c == ':' || c == '%' || u >= 0x80;
+    }
+
+    std::string parsePrefixedName() {
+        const size_t colon = s_.find(':', p_);
+        if (colon == std::string::npos) fail("Prefixed Name erwartet");
+        const std::string prefix = s_.substr(p_, colon - p_);
+        auto it = prefixes_.find(prefix);
+        if (it == prefixes_.end()) fail("unbekannter Prefix '" + prefix + "'");
+        p_ = colon + 1;
+        std::string local;
+        while (!eof()) {
+            const char c = s_[p_];
+            if (c == '\\' && p_ + 1 < s_.size()) { local += s_[p_ + 1]; p_ += 2; continue; }
+            if (!isPnChar(c)) break;
+            // '.' am Ende gehört zum Statement-Abschluss, nicht zum Namen
+            if (c == '.' && (p_ + 1 >= s_.size() || !isPnChar(s_[p_ + 1]) || s_[p_ + 1] == '.')) break;
+            local += c; ++p_;
+        }
+        return it->second + local;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) { out += static_cast<char>(cp); }
+        else if (cp < 0x800) { out += static_cast<char>(0xC0 | (cp >> 6));
+                               out += static_cast<char>(0x80 | (cp & 0x3F)); }
+        else if (cp < 0x10000) { out += static_cast<char>(0xE0 | (cp >> 12));
+                                 out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                                 out += static_cast<char>(0x80 | (cp & 0x3F)); }
+        else { out += static_cast<char>(0xF0 | (cp >> 18));
+               out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+               out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+               out += static_cast<char>(0x80 | (cp & 0x3F)); }
+    }
+
+    // p_ steht auf '\\' – liefert das dekodierte Zeichen (UTF-8) und rückt vor.
+    std::string unescapeAt() {
+        const char c = s_[p_ + 1];
+        p_ += 2;
+        switch (c) {
+            case 'n': return "\n";
+            case 'r': return "\r";
+            case 't': return "\t";
+            case 'b': return "\b";
+            case 'f': return "\f";
+            case 'u': case 'U': {
+                const size_t n = (c == 'u') ? 4 : 8;
+                if (p_ + n > s_.size()) fail("Unicode-Escape unvollständig");
+                const uint32_t cp = static_cast<uint32_t>(std::stoul(s_.substr(p_, n), nullptr, 16));
+                p_ += n;
+                std::string out; appendUtf8(out, cp);
+                return out;
+            }
+            default: return std::string(1, c);   // \" \' \\ usw.
+        }
+    }
+
+    Term parseLiteral() {
+        const char q = peek();
+        const bool longForm = (p_ + 2 < s_.size() && s_[p_ + 1] == q && s_[p_ + 2] == q);
+        p_ += longForm ? 3 : 1;
+        Term t; t.literal = true;
+        for (;;) {
+            if (eof()) fail("Literal nicht abgeschlossen");
+            const char c = s_[p_];
+            if (c == '\\') { t.value += unescapeAt(); continue; }
+            if (c == q) {
+                if (!longForm) { ++p_; break; }
+                if (p_ + 2 < s_.size() && s_[p_ + 1] == q && s_[p_ + 2] == q) { p_ += 3; break; }
+            }
+            t.value += c; ++p_;
+        }
+        // Sprach-Tag oder Datentyp überlesen
+        if (peek() == '@') {
+            ++p_;
+            while (!eof() && (std::isalnum(static_cast<unsigned char>(s_[p_])) || s_[p_] == '-')) ++p_;
+        } else if (startsWith("^^")) {
+            p_ += 2;
+            if (peek() == '<') (void)parseIriRef(); else (void)parsePrefixedName();
+        }
+        return t;
+    }
+
+    Term parseNumberOrBool() {
+        Term t; t.literal = true;
+        if (startsWith("true"))  { p_ += 4; t.value = "true";  return t; }
+        if (startsWith("false")) { p_ += 5; t.value = "false"; return t; }
+        while (!eof()) {
+            const char c = s_[p_];
+            if (std::isdigit(static_cast<unsigned char>(c)) || c == '+' || c == '-' || c == 'e' || c == 'E') {
+                t.value += c; ++p_; continue;
+            }
+            if (c == '.' && p_ + 1 < s_.size() && std::isdigit(static_cast<unsigned char>(s_[p_ + 1]))) {
+                t.value += c; ++p_; continue;
+            }
+            break;
+        }
+        if (t.value.empty()) fail("unerwartetes Zeichen");
+        return t;
+    }
+
+    Term newBlank() { return Term{ false, "_:b" + std::to_string(++bnodes_) }; }
+
+    Term parseBlankNodeLabel() {
+        p_ += 2;
+        std::string label;
+        while (!eof() && isPnChar(s_[p_]) && s_[p_] != ':') label += s_[p_++];
+        if (!label.empty() && label.back() == '.') { label.pop_back(); --p_; }
+        return Term{ false, "_:" + label };
+    }
+
+    Term parseBlankPropertyList() {
+        ++p_;                        // '['
+        Term b = newBlank();
+        skipWs();
+        if (peek() != ']') parsePredicateObjectList(b);
+        expect(']');
+        return b;
+    }
+
+    Term parseCollection() {
+        ++p_;                        // '('
+        for (;;) {
+            skipWs();
+            if (eof()) fail("Collection nicht abgeschlossen");
+            if (peek() == ')') { ++p_; break; }
+            (void)parseObject();
+        }
+        return newBlank();
+    }
+
+    Term parseSubject() {
+        skipWs();
+        const char c = peek();
+        if (c == '<') return Term{ false, parseIriRef() };
+        if (c == '[') return parseBlankPropertyList();
+        if (c == '(') return parseCollection();
+        if (startsWith("_:")) return parseBlankNodeLabel();
+        return Term{ false, parsePrefixedName() };
+    }
+
+    Term parseVerb() {
+        skipWs();
+        if (peek() == 'a' && p_ + 1 < s_.size() &&
+            (std::isspace(static_cast<unsigned char>(s_[p_ + 1])) || s_[p_ + 1] == '<')) {
+            ++p_;
+            return Term{ false, kRdfType };
+        }
+        if (peek() == '<') return Term{ false, parseIriRef() };
+        return Term{ false, parsePrefixedName() };
+    }
+
+    Term parseObject() {
+        skipWs();
+        const char c = peek();
+        if (c == '"' || c == '\'') return parseLiteral();
+        if (c == '<') return Term{ false, parseIriRef() };
+        if (c == '[') return parseBlankPropertyList();
+        if (c == '(') return parseCollection();
+        if (startsWith("_:")) return parseBlankNodeLabel();
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '+' || c == '-' || c == '.' ||
+            ((startsWith("true") || startsWith("false")) && !isPrefixed()))
+            return parseNumberOrBool();
+        return Term{ false, parsePrefixedName() };
+    }
+
+    // "true:" / "false:" wären Prefixed Names
+    bool isPrefixed() const {
+        size_t q = p_;
+        while (q < s_.size() && std::isalpha(static_cast<unsigned char>(s_[q]))) ++q;
+        return q < s_.size() && s_[q] == ':';
+    }
+
+    void parsePredicateObjectList(const Term& subj) {
+        for (;;) {
+            skipWs();
+            const char c = peek();
+            if (c == '.' || c == ']' || eof()) return;
+            const Term pred = parseVerb();
+            for (;;) {
+                const Term obj = parseObject();
+                emit_(subj, pred, obj);
+                skipWs();
+                if (peek() == ',') { ++p_; continue; }
+                break;
+            }
+            skipWs();
+            if (peek() != ';') return;
+            while (peek() == ';') { ++p_; skipWs(); }
+        }
+    }
+
+    void parseTriples() {
+        const bool anonSubject = (peek() == '[');
+        const Term subj = parseSubject();
+        skipWs();
+        if (!(anonSubject && peek() == '.'))
+            parsePredicateObjectList(subj);
+        expect('.');
+    }
+};
+
+} // namespace
+
+// ---------- Laden & Indizes aufbauen -----------------------------------------
+bool KGIndex::loadTurtleFile(const std::string& path) {
+    const auto t0 = std::chrono::steady_clock::now();
+
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        std::cerr << "[KGIndex] Datei nicht lesbar: " << path << "\n";
+        return false;
+    }
+    std::ostringstream ss; ss << f.rdbuf();
+    const std::string src = ss.str();
+
+    auto t = std::make_shared<Tables>();
+    auto intern = [&](const std::string& iri) -> uint32_t {
+        auto [it, inserted] = t->ids.emplace(iri, static_cast<uint32_t>(t->iris.size()));
+        if (inserted) t->iris.push_back(iri);
+        return it->second;
+    };
+
+    const std::string pType = kRdfType;
+    const std::string cFM = kCL + "FailureMode",  cFunc = kCL + "Function";
+    const std::string cMA = kCL + "MonitoringAction", cSR = kCL + "SystemReaction";
+    const std::string pPrevents = kOP + "preventsFunction";
+    const std::string pMonitors = kOP + "monitorsFailureMode";
+    const std::string pReacts   = kOP + "reactsOnFailureMode";
+    const std::string pFMParams = kDP + "hasFailureModeParams";
+    const std::string pMAParams = kDP + "hasMonActParams";
+    const std::string pSRParams = kDP + "hasSysReactParams";
+
+    // Rohkanten (in Dateireihenfolge), Typen und Parameter-Literale
+    std::unordered_set<uint32_t> isFM, isFunc, isMA, isSR;
+    std::vector<std::pair<uint32_t, uint32_t>> fmSkill, maFM, srFM;
+    std::unordered_map<uint32_t, std::vector<std::string>> fmParams, maParams, srParams;
+
+    try {
+        TurtleReader reader(src, [&](const Term& s, const Term& p, const Term& o) {
+            ++t->triples;
+            if (s.literal) return;
+            const std::string& pv = p.value;
+            if (pv == pType && !o.literal) {
+                if      (o.value == cFM)   isFM.insert(intern(s.value));
+                else if (o.value == cFunc) isFunc.insert(intern(s.value));
+                else if (o.value == cMA)   isMA.insert(intern(s.value));
+                else if (o.value == cSR)   isSR.insert(intern(s.value));
+            }
+            else if (pv == pPrevents && !o.literal) fmSkill.emplace_back(intern(s.value), intern(o.value));
+            else if (pv == pMonitors && !o.literal) maFM.emplace_back(intern(s.value), intern(o.value));
+            else if (pv == pReacts   && !o.literal) srFM.emplace_back(intern(s.value), intern(o.value));
+            else if (pv == pFMParams && o.literal)  fmParams[intern(s.value)].push_back(o.value);
+            else if (pv == pMAParams && o.literal)  maParams[intern(s.value)].push_back(o.value);
+            else if (pv == pSRParams && o.literal)  srParams[intern(s.value)].push_back(o.value);
+        });
+        reader.parse();
+    } catch (const std::exception& e) {
+        std::cerr << "[KGIndex] Parsefehler in " << path << ": " << e.what() << "\n";
+        return false;
+    }
+
+    // Bucket füllen (DISTINCT über (iri, params) wie im SPARQL-SELECT DISTINCT)
+    auto addEntries = [&](std::unordered_map<uint32_t, Bucket>& index, uint32_t key, uint32_t item,
+                          const std::vector<std::string>& params) {
+        Bucket& b = index[key];
+        for (const auto& prm : params) {
+            bool dup = false;
+            for (const auto& e : b.entries)
+                if (e.iri == t->iris[item] && e.params == prm) { dup = true; break; }
+            if (dup) continue;
+
+            Entry e{ t->iris[item], prm, json{} };
+            json j = json::parse(prm, nullptr, /*allow_exceptions*/false);
+            if (!j.is_discarded() && j.is_object() && j.contains("rows")) e.rows = j["rows"];
+            if (!b.text.empty()) b.text += "\n";
+            b.text += e.iri;
+            b.text += "\n";
+            b.text += e.params;
+            b.entries.push_back(std::move(e));
+        }
+    };
+
+    const uint32_t defaultMonAct = intern(std::string(kOntIri) + "checkParameters");
+
+    // Schleife: FailureMode -preventsFunction-> Skill
+    for (const auto& [fm, skill] : fmSkill) {
+        if (!isFM.count(fm) || !isFunc.count(skill)) continue;
+        auto it = fmParams.find(fm);
+        if (it != fmParams.end()) addEntries(t->bySkill, skill, fm, it->second);
+    }
+    // Schleife: MonitoringAction -monitorsFailureMode-> FailureMode
+    for (const auto& [ma, fm] : maFM) {
+        if (ma == defaultMonAct || !isMA.count(ma) || !isFM.count(fm)) continue;
+        auto it = maParams.find(ma);
+        if (it != maParams.end()) addEntries(t->monActByFM, fm, ma, it->second);
+    }
+    // Schleife: SystemReaction -reactsOnFailureMode-> FailureMode
+    for (const auto& [sr, fm] : srFM) {
+        if (!isSR.count(sr) || !isFM.count(fm)) continue;
+        auto it = srParams.find(sr);
+        if (it != srParams.end()) addEntries(t->sysReactByFM, fm, sr, it->second);
+    }
+
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+    std::cout << "[KGIndex] " << path << ": triples=" << t->triples
+              << " skills=" << t->bySkill.size()
+              << " fm(monAct)=" << t->monActByFM.size()
+              << " fm(sysReact)=" << t->sysReactByFM.size()
+              << " in " << ms << " ms\n";
+
+    {
+        std::lock_guard<std::mutex> lk(mx_);
+        tables_ = std::move(t);
+    }
+    // Payloads können sich geändert haben -> kompilierte Plan-Vorlagen verwerfen
+    invalidateCompiledPlans();
+    return true;
+}
+
+// ---------- Lookups ----------------------------------------------------------
+std::shared_ptr<const KGIndex::Tables> KGIndex::tables() const {
+    std::lock_guard<std::mutex> lk(mx_);
+    return tables_;
+}
+
+bool KGIndex::loaded() const { return tables() != nullptr; }
+
+size_t KGIndex::tripleCount() const {
+    auto t = tables();
+    return t ? t->triples : 0;
+}
+
+const KGIndex::Bucket* KGIndex::find(const Tables& t,
+                                     const std::unordered_map<uint32_t, Bucket>& m,
+                                     const std::string& iri) {
+    auto id = t.ids.find(iri);
+    if (id == t.ids.end()) return nullptr;
+    auto it = m.find(id->second);
+    return it == m.end() ? nullptr : &it->second;
+}
+
+bool KGIndex::failureModeParameters(const std::string& skillName, std::string& out) const {
+    auto t = tables();
+    if (!t) return false;
+    const Bucket* b = find(*t, t->bySkill, std::string(kOntIri) + skillName);
+    out = b ? b->text : std::string{};
+    return true;
+}
+
+bool KGIndex::monitoringActionsForFM(const std::string& fmIri, std::string& out) const {
+    auto t = tables();
+    if (!t) return false;
+    const Bucket* b = find(*t, t->monActByFM, fmIri);
+    out = b ? b->text : std::string{};
+    return true;
+}
+
+bool KGIndex::systemReactionsForFM(const std::string& fmIri, std::string& out) const {
+    auto t = tables();
+    if (!t) return false;
+    const Bucket* b = find(*t, t->sysReactByFM, fmIri);
+    out = b ? b->text : std::string{};
+    return true;
+}
+
+bool KGIndex::failureModesForSkill(const std::string& skillName, std::vector<Entry>& out) const {
+    auto t = tables();
+    if (!t) return false;
+    const Bucket* b = find(*t, t->bySkill, std::string(kOntIri) + skillName);
+    out = b ? b->entries : std::vector<Entry>{};
+    return true;
+}
+
+bool KGIndex::monitoringActionEntries(const std::string& fmIri, std::vector<Entry>& out) const {
+    auto t = tables();
+    if (!t) return false;
+    const Bucket* b = find(*t, t->monActByFM, fmIri);
+    out = b ? b->entries : std::vector<Entry>{};
+    return true;
+}
+
+bool KGIndex::systemReactionEntries(const std::string& fmIri, std::vector<Entry>& out) const {
+    auto t = tables();
+    if (!t) return false;
+    const Bucket* b = find(*t, t->sysReactByFM, fmIri);
+    out = b ? b->entries : std::vector<Entry>{};
+    return true;
+}
@@ -1,6 +1,6 @@
 // KGIngestionForce.cpp
 // CommandForce, die die eigentliche KG-Ingestion über das KG_Interface (Python) anstößt.
-// Sie übersetzt die Operation in KGIngestionParams und delegiert dann an den PythonWorker.
+// Sie übersetzt die Operation in KGIngestionParams und delegiert dann asynchron an den PythonWorker.
 #include "KgIngestionForce.h"
 #include "Acks.h"
 #include <pybind11/embed.h>
@@ -61,7 +61,7 @@ KgIngestionForce::Parameters KgIngestionForce::buildParams(const Plan& p) {
     Parameters out;
     const auto& op = p.ops.front();
 
-    out.corr       = p.correlationId.empty() ? getStr(op.inputs, 0) : p.correlationId;
+    out.corr       = p.correlationId.valid() ? p.correlationId.str() : getStr(op.inputs, 0);
     out.process    = getStr(op.inputs, 1);
     out.summary    = getStr(op.inputs, 2);
     out.resourceId = p.resourceId;
@@ -112,28 +112,24 @@ int KgIngestionForce::execute(const Plan& p) {
 
     // Ack: geplant
     bus_.post({ EventType::evIngestionPlanned, Clock::now(),
-        std::any{ IngestionPlannedAck{ prm->corr, prm->resourceId, "KGIngestion" } } });
-
-    bool ok = true;
-    std::string py_err;
-
-    try {
-        PythonWorker::instance().call([&]() -> std::string {
-            namespace py = pybind11;
-
-            // (Optional) Pfad setzen – nur falls nicht global erledigt
-            py::module_ sys = py::module_::import("sys");
-            sys.attr("path").cast<py::list>().append(
-                R"(C:\Users\Alexander Verkhov\OneDrive\Dokumente\MPA\Implementierung_MPA\Test\src)"
-            );
-
-            // Modul/Instanz 1x holen; Funktion 1x auflösen
-            static py::object func;      // Cache über Aufrufe hinweg
-            if (!func) {
-                py::module_ kg = py::module_::import("KG_Interface");
-                py::object kgi = kg.attr("KGInterface")();
-                func = kgi.attr("ingestOccuredFailure");
-            }
+        IngestionPlannedAck{ prm->corr, prm->resourceId, "KGIngestion" } });
+
+    // Asynchron: Job im PythonWorker einreihen und sofort zurückkehren (der Bus-Thread
+    // blockiert nicht mehr). Python hängt nur die neuen Tripel ans Delta-Journal an;
+    // evIngestionDone kommt aus dem Worker, sobald der Aufruf durch ist.
+    EventBus* bus = &bus_;
+    PythonWorker::instance().post([prm, bus]() {
+        namespace py = pybind11;
+        bool ok = true;
+        std::string py_err;
+        // Snapshot-JSON erst hier (Worker-Thread) und genau einmal aus dem nativen Snapshot;
+        // reines C++ -> GIL solange freigeben
+        try { py::gil_scoped_release nogil; prm->materializeSnapshot(); }
+        catch (const std::exception& e) { std::cerr << "[KgIngestion] snapshot json failed: " << e.what() << "\n"; }
+        try {
+            // Gleiche KG-Session wie die Abfragen: neue Tripel sind sofort für
+            // spätere Queries sichtbar, ohne das TTL neu zu parsen.
+            py::object func = PythonWorker::instance().kg().attr("ingestOccuredFailure");
 
             py::object monArg = py::none();
             if (!prm->ExecmonReactions.empty()) {
@@ -153,16 +149,15 @@ int KgIngestionForce::execute(const Plan& p) {
                 py::cast(prm->summary),            // summary
                 py::cast(prm->snapshotWrapped)     // PLCsnapshot (String / Wrapper)
             );
-            return std::string{"ok"};
-        });
-    } catch (const std::exception& e) {
-        ok = false; py_err = e.what();
-    }
+        } catch (const std::exception& e) {
+            ok = false; py_err = e.what();
+        }
 
-    // Ack: fertig
-    bus_.post({ EventType::evIngestionDone, Clock::now(),
-        std::any{ IngestionDoneAck{ prm->corr, ok ? 1 : 0,
-            ok ? "ingested via single-call" : ("pyerr: " + py_err) } } });
+        // Ack: fertig
+        bus->post({ EventType::evIngestionDone, Clock::now(),
+            IngestionDoneAck{ prm->corr, ok ? 1 : 0,
+                ok ? "ingested via delta journal" : ("pyerr: " + py_err) } });
+    });
 
-    return ok ? 1 : 0;
+    return 1;   // angenommen; Ergebnis via evIngestionDone
 }
\ No newline at end of file
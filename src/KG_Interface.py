@@ -1,11 +1,72 @@
 # kg_interface.py
 from rdflib import Graph, URIRef, Namespace, Literal
 from rdflib.namespace import RDF, XSD
+from rdflib.plugins.sparql import prepareQuery
 from typing import Sequence
+from contextlib import contextmanager
+import os
+import shutil
+import threading
+import time
 
-class KGInterface:
+
+class _RWLock:
+    """Leser/Schreiber-Sperre: beliebig viele Abfragen gleichzeitig, Schreiber exklusiv.
+    Wartende Schreiber haben Vorrang, damit Ingestion nicht hinter Abfragen verhungert."""
     def __init__(self):
-        self.ontology_path = r"C:\Users\Alexander Verkhov\OneDrive\Dokumente\MPA\Implementierung_MPA\MSRGuard\src\FMEA_KG.ttl"
+        self._cv = threading.Condition(threading.Lock())
+        self._readers = 0
+        self._writer = False
+        self._waitingWriters = 0
+
+    @contextmanager
+    def read(self):
+        with self._cv:
+            while self._writer or self._waitingWriters:
+                self._cv.wait()
+            self._readers += 1
+        try:
+            yield
+        finally:
+            with self._cv:
+                self._readers -= 1
+                if self._readers == 0:
+                    self._cv.notify_all()
+
+    @contextmanager
+    def write(self):
+        with self._cv:
+            self._waitingWriters += 1
+            while self._writer or self._readers:
+                self._cv.wait()
+            self._waitingWriters -= 1
+            self._writer = True
+        try:
+            yield
+        finally:
+            with self._cv:
+                self._writer = False
+                self._cv.notify_all()
+
+
+class KGInterface:
+    # Langlebige KG-Session: Graph wird genau einmal geparst, die SPARQL-Abfragen werden
+    # einmal vorbereitet (prepareQuery) und pro Aufruf nur noch mit initBindings ausgeführt.
+    # Die Instanz wird vom C++-PythonWorker gehalten (startKgSession/kg()).
+    # Ingestion schreibt nur noch die neuen Tripel in ein N-Triples-Journal (<ttl>.delta.nt,
+    # fsync gebündelt); ein Hintergrund-Compactor schreibt periodisch das Basis-TTL neu und
+    # leert das Journal. Beim Start wird ein vorhandenes Journal nachgeladen.
+    # Der PythonWorker ist ein Thread-Pool (ein GIL, keine echte Parallelität): Abfragen
+    # laufen unter der Lesesperre von self._rw gleichzeitig (der GIL wechselt zwischen
+    # ihnen), eine langsame Abfrage hält andere also nicht bis zu ihrem Ende auf. Exklusiv
+    # (Schreibsperre) sind nur das Einfügen der Ingestion-Tripel samt Journal-Append sowie
+    # Kopie + Journal-Rotation im Compactor.
+    FSYNC_BATCH = 16            # spätestens nach so vielen Appends fsync
+    FSYNC_INTERVAL_S = 1.0      # ... oder nach dieser Zeit
+    COMPACT_INTERVAL_S = 300.0  # Compactor-Periode
+
+    def __init__(self, ontology_path: str | None = None, compact_interval_s: float | None = None):
+        self.ontology_path = ontology_path or r"C:\Users\Alexander Verkhov\OneDrive\Dokumente\MPA\Implementierung_MPA\MSRGuard\src\FMEA_KG.ttl"
         self.ont_iri = "http://www.semanticweb.org/FMEA_VDA_AIAG_2021/"
         self.class_prefix = self.ont_iri + "class_"
         self.op_prefix = self.ont_iri + "op_"
@@ -16,87 +77,207 @@ class KGInterface:
         self.CL = Namespace(self.class_prefix)
         self.OP = Namespace(self.op_prefix)
         self.DP = Namespace(self.dp_prefix)
+        self._prepareQueries()
 
-    def getFailureModeParameters(self, interruptedSkill: str) -> str:
-        """Gibt rows-JSON zurück: [{"potFM","FMParam","t","v"} ...]"""
+        # Delta-Journal + Compactor
+        self.delta_path = self.ontology_path + ".delta.nt"
+        self.delta_old_path = self.delta_path + ".old"   # rotiertes Journal während compact()
+        self._rw = _RWLock()
+        self._compactLock = threading.Lock()   # eine Compaction zur Zeit (Compactor vs. close())
+        self._replayDelta()
+        self._delta = open(self.delta_path, "a", encoding="utf-8", newline="\n")
+        self._unsynced = 0
+        self._lastSync = time.monotonic()
+        self._deltaTriples = 0
+        self._compactInterval = compact_interval_s or self.COMPACT_INTERVAL_S
+        self._stop = threading.Event()
+        self._compactor = threading.Thread(target=self._compactLoop, name="KGCompactor", daemon=True)
+        self._compactor.start()
+
+    def _prepareQueries(self):
+        """Parst/übersetzt die drei Lookup-Abfragen einmalig; IRIs kommen per initBindings."""
+        ns = {"cl": self.CL, "op": self.OP, "dp": self.DP}
         base_sep = '' if self.ont_iri.endswith(('#','/')) else '#'
-        searchSkillIri = self.ont_iri + base_sep + interruptedSkill
+        defaultIri = self.ont_iri + base_sep + "checkParameters"
 
-        query = f"""
-            PREFIX cl: <{self.class_prefix}>
-            PREFIX op: <{self.op_prefix}>
-            PREFIX dp: <{self.dp_prefix}>
+        self._qFailureModeParams = prepareQuery("""
             SELECT DISTINCT ?potFM ?FMParam
-            WHERE {{
+            WHERE {
                 ?potFM a cl:FailureMode ;
-                       op:preventsFunction <{searchSkillIri}> ;
+                       op:preventsFunction ?skill ;
                        dp:hasFailureModeParams ?FMParam .
-                <{searchSkillIri}> a cl:Function .
-            }}
-        """
-        res = self.graph.query(query)
-        output_lines = []
-        for row in res:  # row ist rdflib.query.ResultRow
-            potFM = str(row["potFM"])    # URIRef → str
-            fmparam = str(row["FMParam"])
-            # Platzhalter für Typ/Wert (falls später im KG abgelegt):
-            #print(f"potFM: {potFM}    FMParam: {fmparam}")
-            output_lines.append(potFM)
-            output_lines.append(fmparam)
-
-        return "\n".join(output_lines)
-    
-    def getMonitoringActionForFailureMode(self, FMIri: str) -> str:
-        base_sep = '' if self.ont_iri.endswith(('#','/')) else '#'
-        defaultIri = self.ont_iri + base_sep + "checkParameters"
-        query = f"""
-            PREFIX cl: <{self.class_prefix}>
-            PREFIX op: <{self.op_prefix}>
-            PREFIX dp: <{self.dp_prefix}>
+                ?skill a cl:Function .
+            }
+        """, initNs=ns)
+
+        self._qMonitoringAction = prepareQuery(f"""
             SELECT DISTINCT ?monAct ?monActParams
             WHERE {{
-                <{FMIri}> a cl:FailureMode .
+                ?fm a cl:FailureMode .
                 ?monAct a cl:MonitoringAction ;
-                        op:monitorsFailureMode <{FMIri}> ;
+                        op:monitorsFailureMode ?fm ;
                         dp:hasMonActParams ?monActParams .
-                FILTER( ?monAct != IRI("{defaultIri}") )
+                FILTER( ?monAct != <{defaultIri}> )
             }}
-        """
-        #print(query)
-        res = self.graph.query(query)
-
-        output_lines = []
-        for row in res:
-            sysR   = str(row["monAct"])
-            params = str(row["monActParams"])
-            output_lines.append(sysR)
-            output_lines.append(params)
-
-        return "\n".join(output_lines)
-    
-    def getSystemreactionForFailureMode(self, FMIri: str) -> str:
-        query = f"""
-            PREFIX cl: <{self.class_prefix}>
-            PREFIX op: <{self.op_prefix}>
-            PREFIX dp: <{self.dp_prefix}>
+        """, initNs=ns)
+
+        self._qSystemReaction = prepareQuery("""
             SELECT DISTINCT ?sysReact ?SysReactParams
-            WHERE {{
-                <{FMIri}> a cl:FailureMode .
+            WHERE {
+                ?fm a cl:FailureMode .
                 ?sysReact a cl:SystemReaction ;
-                        op:reactsOnFailureMode <{FMIri}> ;
-                        dp:hasSysReactParams ?SysReactParams .
-            }}
-        """
-        res = self.graph.query(query)
+                          op:reactsOnFailureMode ?fm ;
+                          dp:hasSysReactParams ?SysReactParams .
+            }
+        """, initNs=ns)
+
+    def warmUp(self) -> int:
+        """Führt jede vorbereitete Abfrage einmal aus (Lazy-Init in rdflib). Rückgabe: #Tripel."""
+        probe = URIRef(self.ont_iri + "__warmup__")
+        list(self.graph.query(self._qFailureModeParams, initBindings={"skill": probe}))
+        list(self.graph.query(self._qMonitoringAction,  initBindings={"fm": probe}))
+        list(self.graph.query(self._qSystemReaction,    initBindings={"fm": probe}))
+        return len(self.graph)
 
-        output_lines = []
-        for row in res:
-            sysR   = str(row["sysReact"])
-            params = str(row["SysReactParams"])
-            output_lines.append(sysR)
-            output_lines.append(params)
+    # ---------- Delta-Journal / Compaction ----------
+    @staticmethod
+    def _ntTerm(t) -> str:
+        """Ein Term in N-Triples-Notation (Literale immer einzeilig escaped)."""
+        if isinstance(t, Literal):
+            v = (str(t).replace("\\", "\\\\").replace('"', '\\"')
+                       .replace("\n", "\\n").replace("\r", "\\r"))
+            if t.language:
+                return f'"{v}"@{t.language}'
+            if t.datatype:
+                return f'"{v}"^^<{t.datatype}>'
+            return f'"{v}"'
+        return f"<{t}>"
 
-        return "\n".join(output_lines)
+    def _replayDelta(self):
+        """Journal(e) aus einem vorherigen Lauf (noch nicht kompaktiert) in den Graphen laden.
+        Ein .old-Journal bleibt nur stehen, wenn compact() vor dem Einarbeiten ins Basis-TTL
+        abbrach; weitere Rotationen hängen dann daran an."""
+        for path in (self.delta_old_path, self.delta_path):
+            if os.path.exists(path) and os.path.getsize(path) > 0:
+                before = len(self.graph)
+                self.graph.parse(path, format="nt")
+                print(f"[KG] delta replay: +{len(self.graph) - before} triples from {path}")
+
+    def _appendDelta(self, triples) -> None:
+        """Tripel ans Journal anhängen; fsync gebündelt (Anzahl/Zeit). Aufruf unter self._rw.write()."""
+        self._delta.write("".join(
+            f"{self._ntTerm(s)} {self._ntTerm(p)} {self._ntTerm(o)} .\n" for s, p, o in triples))
+        self._delta.flush()
+        self._deltaTriples += len(triples)
+        self._unsynced += 1
+        now = time.monotonic()
+        if self._unsynced >= self.FSYNC_BATCH or now - self._lastSync >= self.FSYNC_INTERVAL_S:
+            os.fsync(self._delta.fileno())
+            self._unsynced = 0
+            self._lastSync = now
+
+    def compact(self) -> int:
+        """Graph ins Basis-TTL schreiben (atomar via tmp + replace) und Journal leeren.
+        Unter der Schreibsperre wird nur eine Kopie des Graphen gezogen und das Journal nach .old
+        rotiert; das (langsame) Serialisieren läuft ohne Lock, Abfragen/Ingestion laufen weiter.
+        Compactions selbst laufen nacheinander (self._compactLock über den ganzen Lauf), damit
+        eine spätere nicht das .old einer noch serialisierenden löscht oder deren TTL überholt.
+        Rückgabe: Anzahl der eingearbeiteten Journal-Tripel."""
+        with self._compactLock:
+            return self._compactLocked()
+
+    def _compactLocked(self) -> int:
+        with self._rw.write():
+            if self._deltaTriples == 0:
+                if self._unsynced:
+                    os.fsync(self._delta.fileno())
+                    self._unsynced = 0
+                return 0
+            snap = Graph()
+            for prefix, ns in self.graph.namespaces():
+                snap.bind(prefix, ns, override=True)
+            for t in self.graph:
+                snap.add(t)
+            merged = self._deltaTriples
+            os.fsync(self._delta.fileno())
+            self._delta.close()
+            if os.path.exists(self.delta_old_path):
+                # .old aus einer fehlgeschlagenen Compaction steckt noch nicht im Basis-TTL:
+                # anhängen statt überschreiben (doppelte Tripel beim Replay sind harmlos)
+                with open(self.delta_path, "rb") as src, open(self.delta_old_path, "ab") as dst:
+                    shutil.copyfileobj(src, dst)
+                    dst.flush()
+                    os.fsync(dst.fileno())
+                os.remove(self.delta_path)
+            else:
+                os.replace(self.delta_path, self.delta_old_path)
+            self._delta = open(self.delta_path, "w", encoding="utf-8", newline="\n")
+            self._deltaTriples = 0
+            self._unsynced = 0
+            self._lastSync = time.monotonic()
+
+        # eigener tmp-Name je Lauf (Prozess/Thread): kein zweiter Schreiber auf derselben Datei
+        tmp = f"{self.ontology_path}.{os.getpid()}.{threading.get_ident()}.tmp"
+        try:
+            snap.serialize(destination=tmp, format="turtle")
+            os.replace(tmp, self.ontology_path)
+        except BaseException:
+            if os.path.exists(tmp):
+                os.remove(tmp)
+            raise
+        os.remove(self.delta_old_path)   # erst jetzt steckt das alte Journal im Basis-TTL
+        print(f"[KG] compacted {merged} delta triples into {self.ontology_path}")
+        return merged
+
+    def _compactLoop(self):
+        while not self._stop.wait(self._compactInterval):
+            try:
+                self.compact()
+            except Exception as e:  # Compactor darf nie sterben
+                print(f"[KG] compaction failed: {e}")
+
+    def close(self):
+        """Compactor stoppen, letzte Deltas einarbeiten (wartet ggf. auf eine laufende Compaction)."""
+        self._stop.set()
+        self._compactor.join(timeout=5.0)
+        self.compact()
+        with self._rw.write():
+            self._delta.close()
+
+    # ---------- Lookups ----------
+    # *Pairs-Varianten: Liste von (IRI, Params-JSON)-Tupeln; der C++-Aufrufer liest die
+    # Strings direkt unter dem GIL (ohne Join/Split über einen Gesamttext).
+    # Die Text-Varianten liefern dasselbe als Zeilen (IRI und Params im Wechsel).
+    def _queryPairs(self, query, bindings: dict, iriVar: str, paramsVar: str) -> list[tuple[str, str]]:
+        with self._rw.read():   # Abfragen gleichzeitig; nur Ingestion/Compactor schließen aus
+            res = self.graph.query(query, initBindings=bindings)
+            return [(str(row[iriVar]), str(row[paramsVar])) for row in res]
+
+    @staticmethod
+    def _joinPairs(pairs: list[tuple[str, str]]) -> str:
+        return "\n".join(s for pair in pairs for s in pair)
+
+    def getFailureModeParameterPairs(self, interruptedSkill: str) -> list[tuple[str, str]]:
+        """(potFM-IRI, FMParam-JSON) je potenziellem FailureMode des Skills."""
+        base_sep = '' if self.ont_iri.endswith(('#','/')) else '#'
+        searchSkillIri = URIRef(self.ont_iri + base_sep + interruptedSkill)
+        return self._queryPairs(self._qFailureModeParams, {"skill": searchSkillIri}, "potFM", "FMParam")
+
+    def getMonitoringActionPairsForFailureMode(self, FMIri: str) -> list[tuple[str, str]]:
+        return self._queryPairs(self._qMonitoringAction, {"fm": URIRef(FMIri)}, "monAct", "monActParams")
+
+    def getSystemreactionPairsForFailureMode(self, FMIri: str) -> list[tuple[str, str]]:
+        return self._queryPairs(self._qSystemReaction, {"fm": URIRef(FMIri)}, "sysReact", "SysReactParams")
+
+    def getFailureModeParameters(self, interruptedSkill: str) -> str:
+        """Gibt Zeilen zurück: potFM-IRI und FMParam-JSON im Wechsel (newline-getrennt)."""
+        return self._joinPairs(self.getFailureModeParameterPairs(interruptedSkill))
+    
+    def getMonitoringActionForFailureMode(self, FMIri: str) -> str:
+        return self._joinPairs(self.getMonitoringActionPairsForFailureMode(FMIri))
+    
+    def getSystemreactionForFailureMode(self, FMIri: str) -> str:
+        return self._joinPairs(self.getSystemreactionPairsForFailureMode(FMIri))
     
     def ingestOccuredFailure(self,id: str,failureModeIRI: str |None,monActIRI: Sequence[str]|None,srIRI: str|None,   # akzeptiert tuple oder list
         lastSkillName: str,lastProcessName: str,summary: str,plcSnapshot: str) -> bool:
@@ -151,15 +332,11 @@ class KGInterface:
             g = self.graph
             CL, OP, DP = self.CL, self.OP, self.DP
 
-            # Für schöne Prefix-Darstellung in den Prints
-            g.bind("cl", self.class_prefix)
-            g.bind("op", self.op_prefix)
-            g.bind("dp", self.dp_prefix)
-
+            # Tripel erst sammeln, dann unter der Schreibsperre einfügen (kurz, Abfragen
+            # warten nur auf das Einfügen + Journal-Append)
             added: list[tuple] = []
 
             def add(s, p, o):
-                g.add((s, p, o))
                 added.append((s, p, o))
 
             # ---- Tripel erzeugen ----
@@ -195,6 +372,16 @@ class KGInterface:
                     if i < len(mon_list) and mon_list[i]:
                         add(URIRef(mon_list[i]), OP.hasMExecutionStamp, ema)
 
+            # ---- Einfügen + Persistieren: nur die neuen Tripel ins Journal (Compactor schreibt das TTL)
+            with self._rw.write():
+                # Für schöne Prefix-Darstellung in den Prints
+                g.bind("cl", self.class_prefix)
+                g.bind("op", self.op_prefix)
+                g.bind("dp", self.dp_prefix)
+                for t in added:
+                    g.add(t)
+                self._appendDelta(added)
+
             # ---- Neue Tripel ausgeben ----
             nm = g.namespace_manager
             print("---INGESTED-TRIPLES----")
@@ -203,9 +390,6 @@ class KGInterface:
             print(f"  (total added: {len(added)})")
             print("---INGESTED-TRIPLES----")
 
-            # Persistieren
-            g.serialize(destination=self.ontology_path, format="turtle")
-
         # Längen bestimmen (robust gegen str vs. list/tuple)
         mon_list = _to_list(monActIRI)
         # Neue IRI-Listen erzeugen
@@ -234,5 +418,5 @@ class KGInterface:
             kwargs["mon_list"] = mon_list
 
         # Aufruf – nur das, was es gibt, wird übergeben
-        insert_sr_and_fm(fm_id, **kwargs)
+        insert_sr_and_fm(fm_id, **kwargs)   # sperrt selbst (nur Einfügen + Journal)
         return True
\ No newline at end of file
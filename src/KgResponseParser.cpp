@@ -0,0 +1,399 @@
+// KgResponseParser.cpp
+// Minimaler JSON-Leser auf std::string_view: liest nur, was die Kandidaten-Rows brauchen
+// (id, t, v), alles andere wird strukturell übersprungen. Strings ohne Escapes bleiben
+// Views in den Eingabetext; nur mit Escapes wird in einen wiederverwendeten Puffer dekodiert.
+#include "KgResponseParser.h"
+#include <charconv>
+#include <cmath>
+#include <string>
+
+namespace {
+
+constexpr int kMaxDepth = 64;
+
+bool isWs(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+struct Cursor {
+    std::string_view s;
+    size_t           p = 0;
+
+    void ws()   { while (p < s.size() && isWs(s[p])) ++p; }
+    char peek() { ws(); return p < s.size() ? s[p] : '\0'; }
+    bool eat(char c) { if (peek() == c) { ++p; return true; } return false; }
+    bool lit(std::string_view w) {
+        if (s.substr(p, w.size()) != w) return false;
+        p += w.size();
+        return true;
+    }
+};
+
+// Skalarer JSON-Wert; str zeigt in den Eingabetext oder in den Puffer des Aufrufers
+struct Scalar {
+    enum class K { Null, Bool, Int, Float, String, Other } k = K::Null;
+    bool             b = false;
+    int64_t          i = 0;
+    double           f = 0.0;
+    std::string_view str;
+};
+
+// Puffer je Feld (Escapes), über alle Zeilen wiederverwendet
+struct RowBufs { std::string key, id, t, v; };
+
+bool readHex4(Cursor& c, unsigned& cp) {
+    if (c.p + 4 > c.s.size()) return false;
+    cp = 0;
+    for (int n = 0; n < 4; ++n) {
+        const char h = c.s[c.p++];
+        cp <<= 4;
+        if      (h >= '0' && h <= '9') cp |= static_cast<unsigned>(h - '0');
+        else if (h >= 'a' && h <= 'f') cp |= static_cast<unsigned>(h - 'a' + 10);
+        else if (h >= 'A' && h <= 'F') cp |= static_cast<unsigned>(h - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+void appendUtf8(std::string& out, unsigned cp) {
+    if (cp < 0x80)         { out.push_back(static_cast<char>(cp)); }
+    else if (cp < 0x800)   { out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                             out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+    else if (cp < 0x10000) { out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                             out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                             out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+    else                   { out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                             out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                             out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                             out.push_back(static_cast<char>(0x80 | (cp & 0x3F))); }
+}
+
+// String ab '"'. Ohne Escapes: View in den Eingabetext, sonst dekodiert in buf.
+bool readString(Cursor& c, std::string_view& out, std::string& buf) {
+    if (!c.eat('"')) return false;
+    const size_t start = c.p;
+    size_t q = start;
+    while (q < c.s.size() && c.s[q] != '"' && c.s[q] != '\\') ++q;
+    if (q >= c.s.size()) return false;
+    if (c.s[q] == '"') {
+        out = c.s.substr(start, q - start);
+        c.p = q + 1;
+        return true;
+    }
+
+    buf.assign(c.s.substr(start, q - start));
+    c.p = q;
+    while (c.p < c.s.size()) {
+        const char ch = c.s[c.p++];
+        if (ch == '"') { out = buf; return true; }
+        if (ch != '\\') { buf.push_back(ch); continue; }
+        if (c.p >= c.s.size()) return false;
+        switch (const char e = c.s[c.p++]) {
+            case '"': case '\\': case '/': buf.push_back(e); break;
+            case 'b': buf.push_back('\b'); break;
+            case 'f': buf.push_back('\f'); break;
+            case 'n': buf.push_back('\n'); break;
+            case 'r': buf.push_back('\r'); break;
+            case 't': buf.push_back('\t'); break;
+            case 'u': {
+                unsigned cp = 0;
+                if (!readHex4(c, cp)) return false;
+                if (cp >= 0xD800 && cp < 0xDC00) {            // Surrogatpaar
+                    unsigned lo = 0;
+                    if (!c.lit("\\u") || !readHex4(c, lo) || lo < 0xDC00 || lo >= 0xE000) return false;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                }
+                appendUtf8(buf, cp);
+                break;
+            }
+            default: return false;
+        }
+    }
+    return false;
+}
+
+bool skipString(Cursor& c) {
+    if (!c.eat('"')) return false;
+    while (c.p < c.s.size()) {
+        const char ch = c.s[c.p++];
+        if (ch == '"') return true;
+        if (ch == '\\') ++c.p;
+    }
+    return false;
+}
+
+// Zahl: ganzzahlig als int64, sonst double
+bool readNumber(Cursor& c, Scalar& out) {
+    const char* b = c.s.data() + c.p;
+    const char* e = c.s.data() + c.s.size();
+    int64_t i = 0;
+    auto ri = std::from_chars(b, e, i);
+    if (ri.ec == std::errc() && (ri.ptr == e || (*ri.ptr != '.' && *ri.ptr != 'e' && *ri.ptr != 'E'))) {
+        out.k = Scalar::K::Int;
+        out.i = i;
+        c.p += static_cast<size_t>(ri.ptr - b);
+        return true;
+    }
+    double d = 0.0;
+    auto rd = std::from_chars(b, e, d);
+    if (rd.ec != std::errc() || !std::isfinite(d)) return false;
+    out.k = Scalar::K::Float;
+    out.f = d;
+    c.p += static_cast<size_t>(rd.ptr - b);
+    return true;
+}
+
+bool skipValue(Cursor& c, int depth = 0) {
+    if (depth > kMaxDepth) return false;
+    switch (c.peek()) {
+        case '"': return skipString(c);
+        case '{':
+            ++c.p;
+            if (c.eat('}')) return true;
+            do {
+                if (!skipString(c) || !c.eat(':') || !skipValue(c, depth + 1)) return false;
+            } while (c.eat(','));
+            return c.eat('}');
+        case '[':
+            ++c.p;
+            if (c.eat(']')) return true;
+            do {
+                if (!skipValue(c, depth + 1)) return false;
+            } while (c.eat(','));
+            return c.eat(']');
+        case 't': return c.lit("true");
+        case 'f': return c.lit("false");
+        case 'n': return c.lit("null");
+        default: { Scalar s; return readNumber(c, s); }
+    }
+}
+
+bool readScalar(Cursor& c, Scalar& out, std::string& buf) {
+    out = Scalar{};
+    switch (c.peek()) {
+        case '"': out.k = Scalar::K::String; return readString(c, out.str, buf);
+        case 't': out.k = Scalar::K::Bool; out.b = true;  return c.lit("true");
+        case 'f': out.k = Scalar::K::Bool; out.b = false; return c.lit("false");
+        case 'n': out.k = Scalar::K::Null; return c.lit("null");
+        case '{': case '[': out.k = Scalar::K::Other; return skipValue(c);
+        default:  return readNumber(c, out);
+    }
+}
+
+// "ns=4;s=OPCUA.x" -> NodeKey{4,'s',"OPCUA.x"}; Kurzform "OPCUA.x" und Unbekanntes als ns=4/'s'
+NodeKey keyFromId(std::string_view full) {
+    NodeKey k;
+    if (full.substr(0, 3) == "ns=") {
+        const size_t semi = full.find(';');
+        if (semi != std::string_view::npos && semi + 2 < full.size() && full[semi + 2] == '=') {
+            unsigned ns = 4;
+            if (std::from_chars(full.data() + 3, full.data() + semi, ns).ec != std::errc()) ns = 4;
+            k.ns   = static_cast<uint16_t>(ns);
+            k.type = full[semi + 1];
+            k.id.assign(full.substr(semi + 3));
+            return k;
+        }
+    }
+    k.id.assign(full);
+    return k;
+}
+
+// Eine Zeile {id, t, v, …} ab '{'; unvollständige Zeilen werden übersprungen,
+// Wert/Tag mit falschem Typ machen den Block ungültig (wie nlohmann::get<> früher)
+bool parseRow(Cursor& c, std::vector<KgExpect>& out, RowBufs& bufs) {
+    if (!c.eat('{')) return false;
+    Scalar id, tag, v;
+    bool hasId = false, hasT = false, hasV = false;
+    if (!c.eat('}')) {
+        do {
+            std::string_view key;
+            if (!readString(c, key, bufs.key) || !c.eat(':')) return false;
+            if      (key == "id") { if (!readScalar(c, id,  bufs.id)) return false; hasId = true; }
+            else if (key == "t")  { if (!readScalar(c, tag, bufs.t))  return false; hasT  = true; }
+            else if (key == "v")  { if (!readScalar(c, v,   bufs.v))  return false; hasV  = true; }
+            else if (!skipValue(c)) return false;
+        } while (c.eat(','));
+        if (!c.eat('}')) return false;
+    }
+    if (!hasId || !hasT || !hasV) return true;
+    if (id.k != Scalar::K::String || tag.k != Scalar::K::String) return false;
+
+    KgExpect e;
+    e.kind = kgKindOfTag(tag.str);
+    const bool num = (v.k == Scalar::K::Int || v.k == Scalar::K::Float || v.k == Scalar::K::Bool);
+    const double asF = (v.k == Scalar::K::Int) ? static_cast<double>(v.i)
+                     : (v.k == Scalar::K::Float) ? v.f : (v.b ? 1.0 : 0.0);
+    switch (e.kind) {
+        case KgValKind::Bool:
+            if (v.k != Scalar::K::Bool) return false;
+            e.expectedBool = v.b;
+            break;
+        case KgValKind::Int16:
+            if (!num) return false;
+            e.expectedI16 = (v.k == Scalar::K::Int) ? static_cast<int16_t>(v.i)
+                          : (std::fabs(asF) < 9.0e18 ? static_cast<int16_t>(static_cast<int64_t>(asF)) : int16_t{0});
+            break;
+        case KgValKind::Float64:
+            if (!num) return false;
+            e.expectedF64 = asF;
+            break;
+        case KgValKind::String:
+            if (v.k != Scalar::K::String) return false;
+            e.expectedStr.assign(v.str);
+            break;
+    }
+    e.key = keyFromId(id.str);
+    out.push_back(std::move(e));
+    return true;
+}
+
+bool parseRows(Cursor& c, std::vector<KgExpect>& out, RowBufs& bufs) {
+    if (!c.eat('[')) return false;
+    if (c.eat(']')) return true;
+    do {
+        const bool ok = (c.peek() == '{') ? parseRow(c, out, bufs) : skipValue(c);
+        if (!ok) return false;
+    } while (c.eat(','));
+    return c.eat(']');
+}
+
+// Objekt ab '{'; nur "rows" (Array) wird gelesen
+bool parseRowsObject(Cursor& c, std::vector<KgExpect>& out, RowBufs& bufs) {
+    if (!c.eat('{')) return false;
+    if (c.eat('}')) return true;
+    do {
+        std::string_view key;
+        if (!readString(c, key, bufs.key) || !c.eat(':')) return false;
+        const bool ok = (key == "rows" && c.peek() == '[') ? parseRows(c, out, bufs) : skipValue(c);
+        if (!ok) return false;
+    } while (c.eat(','));
+    return c.eat('}');
+}
+
+// Ein JSON-Wert: {rows}, [{rows}, …] oder [header, {rows}, …]; sonst keine Zeilen
+bool parseBlock(Cursor& c, std::vector<KgExpect>& out) {
+    RowBufs bufs;
+    const char ch = c.peek();
+    if (ch == '{') return parseRowsObject(c, out, bufs);
+    if (ch != '[') return skipValue(c);
+
+    ++c.p;
+    if (c.eat(']')) return true;
+    size_t n    = 0;
+    bool   used = false;   // erstes Objekt unter den ersten beiden Elementen
+    do {
+        bool ok;
+        if (!used && n < 2 && c.peek() == '{') { ok = parseRowsObject(c, out, bufs); used = true; }
+        else ok = skipValue(c);
+        if (!ok) return false;
+        ++n;
+    } while (c.eat(','));
+    return c.eat(']');
+}
+
+// Ende eines Blocks ab '{' per Klammerzähler (string-aware), zum Wiederaufsetzen nach Fehlern
+size_t balancedEnd(std::string_view s, size_t pos) {
+    int  depth = 0;
+    bool inStr = false, esc = false;
+    for (; pos < s.size(); ++pos) {
+        const char c = s[pos];
+        if (inStr) {
+            if (esc)            { esc = false; continue; }
+            if (c == '\\')      { esc = true;  continue; }
+            if (c == '"')       { inStr = false; }
+            continue;
+        }
+        if (c == '"') { inStr = true; continue; }
+        if (c == '{') { ++depth; continue; }
+        if (c == '}' && --depth == 0) return pos + 1;
+    }
+    return s.size();
+}
+
+bool ieq(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (x != b[i]) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+KgValKind kgKindOfTag(std::string_view t) {
+    switch (t.size()) {
+        case 1:
+            if (ieq(t, "b")) return KgValKind::Bool;
+            if (ieq(t, "i")) return KgValKind::Int16;
+            if (ieq(t, "f")) return KgValKind::Float64;
+            break;
+        case 3:
+            if (ieq(t, "int") || ieq(t, "i16")) return KgValKind::Int16;
+            break;
+        case 4:
+            if (ieq(t, "bool")) return KgValKind::Bool;
+            break;
+        case 5:
+            if (ieq(t, "int16")) return KgValKind::Int16;
+            if (ieq(t, "float")) return KgValKind::Float64;
+            break;
+        case 6:
+            if (ieq(t, "double")) return KgValKind::Float64;
+            break;
+        case 7:
+            if (ieq(t, "boolean")) return KgValKind::Bool;
+            break;
+    }
+    return KgValKind::String;
+}
+
+bool parseKgExpects(std::string_view json, std::vector<KgExpect>& out) {
+    const size_t mark = out.size();
+    Cursor c{ json };
+    if (!parseBlock(c, out) || (c.ws(), c.p != json.size())) {
+        out.resize(mark);
+        return false;
+    }
+    return true;
+}
+
+std::vector<KgCandidate> parseKgCandidates(std::string_view s, KgParseStats* stats) {
+    KgParseStats st;
+    std::vector<KgCandidate> out;
+
+    // Manche Python-Returns kommen als quoted-String
+    if (s.size() >= 2 && s.front() == '"' && s.back() == '"') s = s.substr(1, s.size() - 2);
+
+    size_t pos = 0;
+    while (true) {
+        while (pos < s.size() && isWs(s[pos])) ++pos;
+        if (pos >= s.size()) break;
+
+        // IRI bis zum Zeilenende
+        const size_t eol = s.find_first_of("\r\n", pos);
+        std::string_view iri = s.substr(pos, (eol == std::string_view::npos) ? std::string_view::npos : eol - pos);
+        while (!iri.empty() && (iri.back() == ' ' || iri.back() == '\t')) iri.remove_suffix(1);
+
+        pos = (eol == std::string_view::npos) ? s.size() : eol;
+        while (pos < s.size() && isWs(s[pos])) ++pos;
+
+        // Nächster Block muss ein JSON-Objekt sein; sonst ist die nächste Zeile wieder eine IRI
+        if (pos >= s.size() || s[pos] != '{') { ++st.missingJson; continue; }
+
+        KgCandidate cand{ std::string(iri), {} };
+        Cursor c{ s, pos };
+        if (parseBlock(c, cand.expects)) {
+            pos = c.p;
+        } else {
+            cand.expects.clear();
+            cand.malformed = true;   // nie Gewinner (CompiledChecks: dead)
+            ++st.malformed;
+            pos = balancedEnd(s, pos);
+        }
+        out.push_back(std::move(cand));
+    }
+
+    st.candidates = out.size();
+    if (stats) *stats = st;
+    return out;
+}
@@ -4,11 +4,16 @@
 //   die zugehörige MonitoringAction-Payload aus dem KG (Fetcher).
 // - Baut daraus mit PlanJsonUtils einen Plan aus reinen OpType::CallMethod-Schritten
 //   (ohne DiagnoseFinished-Puls) und führt diese über PLCMonitor::callMethodTyped aus.
+// - Die Kandidaten werden gleichzeitig geprüft (bis maxParallel), die Schritte innerhalb
+//   eines Kandidaten gruppenweise (PlanExecutor): Calls einer Schrittgruppe gehen als ein
+//   CallRequest raus, Gruppen der Reihe nach; die Dauer je Schritt wird mitgeloggt.
 // - Erwartete Outputs (expOuts) werden gegen die tatsächlichen UA-Werte verglichen.
 // - Es bleiben nur die Failure-IRIs im Ergebnis, deren Monitoring-Aktion vollständig OK war.
 
 #include "MonActionForce.h"
 #include "PlanJsonUtils.h"
+#include "CallGroup.h"
+#include "PlanExecutor.h"
 #include "PLCMonitor.h"
 #include "EventBus.h"
 #include "Event.h"
@@ -16,17 +21,92 @@
 #include "Plan.h"
 #include "common_types.h"  
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <iostream>
+#include <sstream>
 #include <chrono>
 
 MonitoringActionForce::MonitoringActionForce(PLCMonitor& mon, EventBus& bus,
                                              Fetcher fetch,
-                                             unsigned defaultTimeoutMs)
-: mon_(mon), bus_(bus), fetch_(std::move(fetch)), defTimeoutMs_(defaultTimeoutMs) {}
+                                             unsigned defaultTimeoutMs,
+                                             unsigned maxParallel)
+: mon_(mon), bus_(bus), fetch_(std::move(fetch)), defTimeoutMs_(defaultTimeoutMs),
+  maxParallel_((std::max)(maxParallel, 1u)) {}
+
+MonitoringActionForce::CandidateResult
+MonitoringActionForce::evaluateCandidate(const std::string& fm, size_t idx, CorrelationId corr)
+{
+    CandidateResult res;
+
+    // 1) MonAction aus KG holen
+    const std::string payload = fetch_(fm);
+    if (payload.empty()) { res.ok = true; return res; }
+    {
+        const auto nl    = payload.find('\n');
+        const auto brace = payload.find('{', (nl==std::string::npos ? 0 : nl));
+        std::string& iri = res.skillIri;
+        iri = (nl==std::string::npos) ? payload.substr(0, brace) : payload.substr(0, nl);
+        // trim:
+        while(!iri.empty() && (iri.back()=='\r' || iri.back()=='\n' || iri.back()==' ' || iri.back()=='\t')) iri.pop_back();
+    }
+
+    // 2) Plan (nur CallMethod) – gecachte Vorlage, die CorrelationId steckt in corr
+    const auto  monPlanPtr = compiledCallMethodPlan(payload, /*appendPulse=*/false, "Station");
+    const Plan& monPlan    = *monPlanPtr;
+
+    // 3) ausführen + Outputs prüfen: je Schrittgruppe ein (gebündelter) CallRequest, danach
+    //    der Vergleich je Schritt; Gruppen nacheinander (Kandidaten laufen bereits parallel)
+    std::vector<CallStepResult> calls(monPlan.ops.size());
+    auto prepare = [&](size_t b, size_t e) {
+        for (size_t s = b; s < e; ++s) {
+            const auto& op = monPlan.ops[s];
+            if (op.type != OpType::CallMethod) continue;
+            const unsigned to = (op.timeoutMs > 0) ? (unsigned)op.timeoutMs : defTimeoutMs_;
+
+            // Zeilen erst zusammenbauen und dann am Stück ausgeben (Kandidaten laufen parallel)
+            std::ostringstream os;
+            os << "[MonAct] " << corr << " fm#" << idx << " step#" << s
+               << " obj='"  << op.callObjNodeId
+               << "' meth='"<< op.callMethNodeId
+               << "' inputs=" << uaMapToJson(op.inputs).dump()
+               << " timeout=" << to << "ms\n";
+            std::cout << os.str();
+        }
+        auto results = executeCallGroup(mon_, monPlan.ops, b, e, defTimeoutMs_);
+        std::move(results.begin(), results.end(), calls.begin() + static_cast<std::ptrdiff_t>(b));
+    };
+    auto step = [&](size_t s) {
+        const auto& op = monPlan.ops[s];
+        if (op.type != OpType::CallMethod) return true;   // MonAct-Pläne: nur CallMethod
+        const UAValueMap& got = calls[s].got;
+
+        bool match = true;
+        if (!op.expOuts.empty()) {
+            for (const auto& [k, vexp] : op.expOuts) {
+                auto it = got.find(k);
+                if (it == got.end() || !::equalUA(vexp, it->second)) { match = false; break; }
+            }
+            std::ostringstream om;
+            om << "[MonAct] " << corr << " fm#" << idx << "   exp=" << uaMapToJson(op.expOuts).dump()
+               << " got=" << uaMapToJson(got).dump()
+               << " -> " << (match ? "MATCH" : "DIFF") << "\n";
+            std::cout << om.str();
+        }
+        return calls[s].callOk && match;
+    };
+    const PlanRunReport rep = executeStepGroups(monPlan.ops, step, /*maxParallel=*/1, prepare);
+    const bool allOk = rep.ok;
+    std::cout << ("[MonAct] " + corr.str() + " fm#" + std::to_string(idx) + " timing " + rep.summary() + "\n");
+
+    res.ok = allOk;
+    if (!allOk) std::cout << ("[MonActionForce] " + corr.str() + " MonitoringAction mismatch for FM: " + fm + "\n");
+    return res;
+}
 
 std::vector<std::string>
 MonitoringActionForce::filter(const std::vector<std::string>& winners,
-                              const std::string& corr,
+                              CorrelationId corr,
                               const std::string& processNameForAck)
 {
     using Clock = std::chrono::steady_clock;
@@ -34,80 +114,53 @@ MonitoringActionForce::filter(const std::vector<std::string>& winners,
     // Ack: PLANNED
     bus_.post(Event{
         EventType::evMonActPlanned, Clock::now(),
-        std::any{ ReactionPlannedAck{ corr, "Station", "MonitoringAction Filter (CallMethod)" } }
+        ReactionPlannedAck{ corr, "Station", "MonitoringAction Filter (CallMethod)" }
     });
 
+    // Kandidaten gleichzeitig prüfen: je Kandidat ein Task, höchstens maxParallel_ in Flug.
+    // Ergebnisse landen per Index in results -> Ausgabe-Reihenfolge wie winners.
+    std::vector<CandidateResult> results(winners.size());
+    auto runOne = [&](size_t k) {
+        try { results[k] = evaluateCandidate(winners[k], k, corr); }
+        catch (const std::exception& e) {
+            std::cerr << "[MonActionForce] candidate " << winners[k] << " failed: " << e.what() << "\n";
+        }
+    };
+
+    if (winners.size() <= 1 || maxParallel_ == 1) {
+        for (size_t k = 0; k < winners.size(); ++k) runOne(k);
+    } else {
+        std::atomic<size_t> next{0};
+        const size_t workers = (std::min)(winners.size(), static_cast<size_t>(maxParallel_));
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(workers);
+        for (size_t w = 0; w < workers; ++w)
+            tasks.push_back(std::async(std::launch::async, [&]{
+                for (size_t k; (k = next.fetch_add(1)) < winners.size(); ) runOne(k);
+            }));
+        for (auto& t : tasks) t.get();
+    }
+
     std::vector<std::string> kept;
     std::vector<std::string> executedSkillIris;
     kept.reserve(winners.size());
-
-    for (const auto& fm : winners) {
-        // 1) MonAction aus KG holen
-        const std::string payload = fetch_(fm);
-        if (payload.empty()) { kept.push_back(fm); continue; }
-        std::string iri;
-        {
-            const auto nl    = payload.find('\n');
-            const auto brace = payload.find('{', (nl==std::string::npos ? 0 : nl));
-            iri = (nl==std::string::npos) ? payload.substr(0, brace) : payload.substr(0, nl);
-            // trim:
-            while(!iri.empty() && (iri.back()=='\r' || iri.back()=='\n' || iri.back()==' ' || iri.back()=='\t')) iri.pop_back();
-        }
-
-        // 2) Plan bauen (nur CallMethod)
-        Plan monPlan = buildCallMethodPlanFromPayload(corr, payload, /*appendPulse=*/false, "Station");
-
-        // 3) ausführen + Outputs prüfen
-        bool allOk = true;
-        for (size_t i = 0; i < monPlan.ops.size(); ++i) {
-            const auto& op = monPlan.ops[i];
-            if (op.type != OpType::CallMethod) continue;
-
-            const unsigned to = (op.timeoutMs > 0) ? (unsigned)op.timeoutMs : defTimeoutMs_;
-
-            std::cout << "[MonAct] step#" << i
-                      << " obj='"  << op.callObjNodeId
-                      << "' meth='"<< op.callMethNodeId
-                      << "' inputs=" << uaMapToJson(op.inputs).dump()
-                      << " timeout=" << to << "ms\n";
-
-            UAValueMap got;
-            const bool callOk = mon_.callMethodTyped(op.callObjNodeId, op.callMethNodeId,
-                                                     op.inputs, got, to);
-
-            bool match = true;
-            if (!op.expOuts.empty()) {
-                for (const auto& [k, vexp] : op.expOuts) {
-                    auto it = got.find(k);
-                    if (it == got.end() || !::equalUA(vexp, it->second)) { match = false; break; }
-                }
-                std::cout << "[MonAct]   exp=" << uaMapToJson(op.expOuts).dump()
-                          << " got=" << uaMapToJson(got).dump()
-                          << " -> " << (match ? "MATCH" : "DIFF") << "\n";
-            }
-
-            allOk = allOk && callOk && match;
-        }
-
-        if (allOk) {
-            kept.push_back(fm);
-            if (!iri.empty()) executedSkillIris.push_back(iri);
-        }else {
-            std::cout << "[MonActionForce] MonitoringAction mismatch for FM: " << fm << "/n";
-        }
+    for (size_t k = 0; k < winners.size(); ++k) {
+        if (!results[k].ok) continue;
+        kept.push_back(winners[k]);
+        if (!results[k].skillIri.empty()) executedSkillIris.push_back(results[k].skillIri);
     }
 
     // Ack: DONE
     bus_.post(Event{
         EventType::evMonActDone, Clock::now(),
-        std::any{ ReactionDoneAck{
+        ReactionDoneAck{
             corr,
             kept.empty() ? 0 : 1,
             kept.empty() ? "NO CANDIDATE PASSED" : "OK"
-        } }
+        }
     });
     bus_.post(Event{ EventType::evMonActFinished, Clock::now(),
-    std::any{ MonActFinishedAck{ corr, executedSkillIris } } });
+    MonActFinishedAck{ corr, executedSkillIris } });
 
     return kept;
-}
\ No newline at end of file
+}
@@ -1,5 +1,10 @@
 // PLCCommandForce (ICommandForce-Implementierung für SPS-Operationen)
 // - Implementiert execute(const Plan&) und führt sequentiell die Operationen aus p.ops aus.
+// - executeAsync(...) nutzt denselben Schrittablauf, legt Wartezeiten (WaitMs, Preclear-
+//   Pause bei PulseBool) aber als Monitor-Timer an und setzt den Plan danach fort
+//   (Continuation), statt den Worker-Thread schlafen zu lassen.
+// - Schrittgruppen (Operation::group, stepGroupEnd): die Schritte einer Gruppe starten
+//   direkt nacheinander, ihre Wartezeiten überlappen; weiter geht es nach der längsten.
 // - Unterstützte OpTypes: WriteBool, PulseBool, WriteInt32, WaitMs, ReadCheck,
 //   BlockResource, RerouteOrders, UnblockResource (vgl. MPA_Draft CommandForceFactory).
 // - Die eigentliche Kommunikation mit der SPS erfolgt über PLCMonitor (post/postDelayed).
@@ -13,26 +18,40 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
-
-PLCCommandForce::PLCCommandForce(PLCMonitor& mon, IOrderQueue* oq)
-    : mon_(mon), oq_(oq) {}
-
-int PLCCommandForce::execute(const Plan& p) {
-    bool ok = true;
-
-    for (const auto& op : p.ops) {
-        switch (op.type) {
-        case OpType::WriteBool: {
-            const bool value = (op.arg == "true" || op.arg == "1");
-            mon_.post([&m = mon_, op, value]{
-                const bool wr = m.writeBool(op.nodeId, op.ns, value);
-                std::cout << "[PLCCommandForce] WriteBool " << op.nodeId
-                          << " ns=" << op.ns << " value=" << (value ? "true" : "false")
-                          << " -> " << (wr ? "OK" : "FAIL") << "\n";
-            });
-            break;
-        }
-        case OpType::PulseBool: {
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Zustand eines laufenden Plans; unabhängig von der PLCCommandForce-Instanz
+struct PlanRun {
+    PLCMonitor*             mon = nullptr;
+    IOrderQueue*            oq  = nullptr;
+    Plan                    plan;
+    size_t                  next = 0;       // nächster Schritt in plan.ops
+    bool                    ok   = true;
+    // Reste von Schritten nach ihrer Wartezeit (ms ab Gruppenstart, Funktion)
+    std::vector<std::pair<int, PLCMonitor::UaFn>> afterWait;
+    ICommandForce::Done     done;
+};
+
+// Führt einen Schritt aus. Rückgabe: Wartezeit in ms, bevor es weitergeht (0 = sofort).
+int stepOp(PlanRun& r, const Operation& op) {
+    PLCMonitor& mon = *r.mon;
+    switch (op.type) {
+    case OpType::WriteBool: {
+        const bool value = (op.arg == "true" || op.arg == "1");
+        mon.post([&m = mon, op, value]{
+            const bool wr = m.writeBool(op.nodeId, op.ns, value);
+            std::cout << "[PLCCommandForce] WriteBool " << op.nodeId
+                      << " ns=" << op.ns << " value=" << (value ? "true" : "false")
+                      << " -> " << (wr ? "OK" : "FAIL") << "\n";
+        });
+        return 0;
+    }
+    case OpType::PulseBool: {
         // Pulsbreite in Millisekunden: aus op.timeoutMs oder Default 100 ms
         const int widthMs = (op.timeoutMs > 0) ? op.timeoutMs : 100;
 
@@ -40,89 +59,160 @@ int PLCCommandForce::execute(const Plan& p) {
         // Falls gewünscht, aus op.arg ableiten, z. B. "preclear"
         const bool doPreclear = (op.arg == "preclear");
 
-        PLCMonitor* pm = &mon_;   // robust in Threads verwenden
+        PLCMonitor* pm = &mon;   // robust in Threads verwenden
         const auto nodeId = op.nodeId;
         const auto ns     = op.ns;
 
-        if (doPreclear) {
+        // HIGH setzen (steigende Flanke auslösen), nach widthMs wieder auf LOW – über Monitor-Timer
+        auto pulse = [pm, nodeId, ns, widthMs]{
             pm->post([pm, nodeId, ns]{
+                const bool wr = pm->writeBool(nodeId, ns, true);
+                std::cout << "[PLCCommandForce] PulseBool HI " << nodeId
+                        << " ns=" << ns << " -> " << (wr ? "OK" : "FAIL") << "\n";
+            });
+            pm->postDelayed(widthMs, [pm, nodeId, ns]{
                 const bool wr = pm->writeBool(nodeId, ns, false);
-                std::cout << "[PLCCommandForce] PulseBool PRECLEAR " << nodeId
+                std::cout << "[PLCCommandForce] PulseBool LO " << nodeId
                         << " ns=" << ns << " -> " << (wr ? "OK" : "FAIL") << "\n";
             });
-            // Kleine Entprell-/SPS-Zeit, damit LOW sicher ankommt
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
-        }
+        };
 
-        // HIGH setzen (steigende Flanke auslösen)
-        pm->post([pm, nodeId, ns]{
-            const bool wr = pm->writeBool(nodeId, ns, true);
-            std::cout << "[PLCCommandForce] PulseBool HI " << nodeId
-                    << " ns=" << ns << " -> " << (wr ? "OK" : "FAIL") << "\n";
-        });
+        if (!doPreclear) { pulse(); return 0; }
 
-        // Nach widthMs wieder auf LOW – sauber über Monitor-Timer
-        pm->postDelayed(widthMs, [pm, nodeId, ns]{
+        pm->post([pm, nodeId, ns]{
             const bool wr = pm->writeBool(nodeId, ns, false);
-            std::cout << "[PLCCommandForce] PulseBool LO " << nodeId
+            std::cout << "[PLCCommandForce] PulseBool PRECLEAR " << nodeId
                     << " ns=" << ns << " -> " << (wr ? "OK" : "FAIL") << "\n";
         });
+        // Kleine Entprell-/SPS-Zeit, damit LOW sicher ankommt; danach der eigentliche Puls
+        r.afterWait.emplace_back(20, std::move(pulse));
+        return 20;
+    }
 
-        break;
+    case OpType::WriteInt32: {
+        // TODO: Implementiere writeInt32 in PLCMonitor, dann hier aktivieren
+        int value = 0;
+        try { value = std::stoi(op.arg); } catch (...) { value = 0; r.ok = false; }
+        std::cout << "[PLCCommandForce] WriteInt32 TODO node=" << op.nodeId
+                  << " ns=" << op.ns << " value=" << value << " (not implemented)\n";
+        // mon.post([&m = mon, op, value]{ m.writeInt32(op.nodeId, op.ns, value); });
+        return 0;
     }
 
-        case OpType::WriteInt32: {
-            // TODO: Implementiere writeInt32 in PLCMonitor, dann hier aktivieren
-            int value = 0;
-            try { value = std::stoi(op.arg); } catch (...) { value = 0; ok = false; }
-            std::cout << "[PLCCommandForce] WriteInt32 TODO node=" << op.nodeId
-                      << " ns=" << op.ns << " value=" << value << " (not implemented)\n";
-            // mon_.post([&m = mon_, op, value]{ m.writeInt32(op.nodeId, op.ns, value); });
-            break;
-        }
+    case OpType::CallMethod: {
+        // TODO: op.arg als JSON der Method-Argumente parsen und callMethod aufrufen
+        std::cout << "[PLCCommandForce] CallMethod TODO node=" << op.nodeId
+                  << " ns=" << op.ns << " args='" << op.arg << "' (not implemented)\n";
+        // mon.post([&m = mon, op]{ m.callMethod(...); });
+        return 0;
+    }
 
-        case OpType::CallMethod: {
-            // TODO: op.arg als JSON der Method-Argumente parsen und callMethod aufrufen
-            std::cout << "[PLCCommandForce] CallMethod TODO node=" << op.nodeId
-                      << " ns=" << op.ns << " args='" << op.arg << "' (not implemented)\n";
-            // mon_.post([&m = mon_, op]{ m.callMethod(...); });
-            break;
-        }
+    case OpType::WaitMs:
+        return (op.timeoutMs > 0) ? op.timeoutMs : 0; // makro-sicher
 
-        case OpType::WaitMs: {
-            const int ms = (op.timeoutMs > 0) ? op.timeoutMs : 0; // makro-sicher
-            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
-            break;
-        }
+    case OpType::ReadCheck: {
+        std::cout << "[PLCCommandForce] ReadCheck TODO node=" << op.nodeId
+                  << " ns=" << op.ns << " expect='" << op.arg
+                  << "' timeoutMs=" << op.timeoutMs << " (not implemented)\n";
+        // Optional: synchron lesen & prüfen -> ok = ok && result;
+        return 0;
+    }
 
-        case OpType::ReadCheck: {
-            std::cout << "[PLCCommandForce] ReadCheck TODO node=" << op.nodeId
-                      << " ns=" << op.ns << " expect='" << op.arg
-                      << "' timeoutMs=" << op.timeoutMs << " (not implemented)\n";
-            // Optional: synchron lesen & prüfen -> ok = ok && result;
-            break;
-        }
+    case OpType::BlockResource: {
+        if (r.oq) r.ok = r.oq->blockResource(op.nodeId) && r.ok;
+        else std::cout << "[PLCCommandForce] BlockResource(" << op.nodeId << ") (noop)\n";
+        return 0;
+    }
 
-        case OpType::BlockResource: {
-            if (oq_) ok = oq_->blockResource(op.nodeId) && ok;
-            else std::cout << "[PLCCommandForce] BlockResource(" << op.nodeId << ") (noop)\n";
-            break;
-        }
+    case OpType::RerouteOrders: {
+        if (r.oq) r.ok = r.oq->reroute(op.nodeId, op.arg) && r.ok;
+        else std::cout << "[PLCCommandForce] RerouteOrders(" << op.nodeId
+                       << ", criteria=" << op.arg << ") (noop)\n";
+        return 0;
+    }
 
-        case OpType::RerouteOrders: {
-            if (oq_) ok = oq_->reroute(op.nodeId, op.arg) && ok;
-            else std::cout << "[PLCCommandForce] RerouteOrders(" << op.nodeId
-                           << ", criteria=" << op.arg << ") (noop)\n";
-            break;
-        }
+    case OpType::UnblockResource: {
+        if (r.oq) r.ok = r.oq->unblockResource(op.nodeId) && r.ok;
+        else std::cout << "[PLCCommandForce] UnblockResource(" << op.nodeId << ") (noop)\n";
+        return 0;
+    }
 
-        case OpType::UnblockResource: {
-            if (oq_) ok = oq_->unblockResource(op.nodeId) && ok;
-            else std::cout << "[PLCCommandForce] UnblockResource(" << op.nodeId << ") (noop)\n";
-            break;
-        }
+    default:
+        return 0;
+    }
+}
+
+// Gruppen ab r.next bis zum Planende oder bis zur ersten Gruppe mit Wartezeit;
+// Rückgabe: längste Wartezeit dieser Gruppe (0 = Plan fertig)
+int runUntilWait(PlanRun& r) {
+    while (r.next < r.plan.ops.size()) {
+        const size_t end = stepGroupEnd(r.plan.ops, r.next);
+        int waitMs = 0;
+        for (; r.next < end; ++r.next)
+            waitMs = (std::max)(waitMs, stepOp(r, r.plan.ops[r.next]));
+        if (waitMs > 0) return waitMs;
+    }
+    return 0;
+}
+
+// done(rc) genau einmal melden
+void finish(PlanRun& r, int rc) {
+    ICommandForce::Done d = std::move(r.done);
+    r.done = nullptr;
+    if (d) d(rc);
+}
+
+// Continuation: weiter bis zur nächsten Wartezeit, dann per Monitor-Timer fortsetzen.
+// Die afterWait-Reste laufen zu ihrer eigenen Zeit; bei gleicher Zeit vor der Fortsetzung
+// (Timer laufen in Einreihungsreihenfolge). Verwirft PLCMonitor::disconnect() den Timer,
+// endet der Plan mit rc=0 (sonst käme done nie).
+void resume(const std::shared_ptr<PlanRun>& r) {
+    const int waitMs = runUntilWait(*r);
+    if (waitMs > 0) {
+        for (auto& [ms, fn] : r->afterWait) r->mon->postDelayed(ms, std::move(fn));
+        r->afterWait.clear();
+        r->mon->postDelayed(waitMs, [r]{ resume(r); }, [r]{
+            std::cout << "[PLCCommandForce] plan aborted (monitor disconnected) at step "
+                      << r->next << "/" << r->plan.ops.size() << "\n";
+            finish(*r, 0);
+        });
+        return;
+    }
+    finish(*r, r->ok ? 1 : 0);
+}
+
+} // namespace
+
+PLCCommandForce::PLCCommandForce(PLCMonitor& mon, IOrderQueue* oq)
+    : mon_(mon), oq_(oq) {}
+
+int PLCCommandForce::execute(const Plan& p) {
+    PlanRun r;
+    r.mon  = &mon_;
+    r.oq   = oq_;
+    r.plan = p;
+    for (;;) {
+        const int waitMs = runUntilWait(r);
+        if (waitMs <= 0) break;
+        // afterWait-Reste nach Zeit geordnet abarbeiten, dann den Rest der Wartezeit
+        std::stable_sort(r.afterWait.begin(), r.afterWait.end(),
+                         [](const auto& a, const auto& b){ return a.first < b.first; });
+        int slept = 0;
+        for (auto& [ms, fn] : r.afterWait) {
+            if (ms > slept) { std::this_thread::sleep_for(std::chrono::milliseconds(ms - slept)); slept = ms; }
+            fn();
         }
+        r.afterWait.clear();
+        if (waitMs > slept) std::this_thread::sleep_for(std::chrono::milliseconds(waitMs - slept));
     }
+    return r.ok ? 1 : 0;
+}
 
-    return ok ? 1 : 0;
+void PLCCommandForce::executeAsync(const Plan& p, Done done) {
+    auto r  = std::make_shared<PlanRun>();
+    r->mon  = &mon_;
+    r->oq   = oq_;
+    r->plan = p;
+    r->done = std::move(done);
+    resume(r);
 }
@@ -3,6 +3,7 @@
 // Kümmert sich um Verbindungen, Reconnect, Lesen/Schreiben, Subscriptions und Hilfsfunktionen,
 // die du im MPA-Draft als Schnittstelle zwischen Framework und PLC spezifiziert hast.
 #include "PLCMonitor.h"
+#include "NodeIdUtils.h"
 
 #include <chrono>
 #include <thread>
@@ -13,6 +14,9 @@
 #include <sstream>
 #include <unordered_set>
 #include <future>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
 
 // ==== Helpers (datei-lokal) =================================================
 namespace {
@@ -93,6 +97,18 @@ std::string variantToString(const UA_Variant *v, std::string &outTypeName) {
         return "<array>";
     }
 }
+// Variant → UAValue (nur Skalare der kleinen UAValue-Typmenge, Rest = monostate)
+UAValue variantToUAValue(const UA_Variant &v) {
+    if (!UA_Variant_isScalar(&v) || !v.type || !v.data) return {};
+    if (v.type == &UA_TYPES[UA_TYPES_BOOLEAN]) return (*static_cast<UA_Boolean*>(v.data) == UA_TRUE);
+    if (v.type == &UA_TYPES[UA_TYPES_INT16])   return static_cast<int16_t>(*static_cast<UA_Int16*>(v.data));
+    if (v.type == &UA_TYPES[UA_TYPES_INT32])   return static_cast<int32_t>(*static_cast<UA_Int32*>(v.data));
+    if (v.type == &UA_TYPES[UA_TYPES_FLOAT])   return static_cast<float>(*static_cast<UA_Float*>(v.data));
+    if (v.type == &UA_TYPES[UA_TYPES_DOUBLE])  return static_cast<double>(*static_cast<UA_Double*>(v.data));
+    if (v.type == &UA_TYPES[UA_TYPES_STRING])  return uaToStdString(*static_cast<UA_String*>(v.data));
+    return {};
+}
+
 // Builtin-Typname aus DataType-NodeId (nur ns=0 sauber mappbar)
 // Builtin-Typname aus DataType-NodeId (nur ns=0 sauber mappbar)
 static std::string typeNameFromNodeId(const UA_NodeId &typeId) {
@@ -499,6 +515,215 @@ bool PLCMonitor::readAsString(const std::string& nodeIdStr,
     return true;
 }
 
+// Batch-Read: alle NodeIds in (wenigen) UA_ReadRequests statt einem Roundtrip je Variable.
+bool PLCMonitor::readValuesBatched(const std::vector<ReadItem>& items,
+                                   std::vector<UAValue>& out,
+                                   size_t maxPerRequest) const {
+    out.assign(items.size(), UAValue{});
+    if (!client_) return false;
+    if (items.empty()) return true;
+    if (maxPerRequest == 0) maxPerRequest = items.size();
+
+    bool allOk = true;
+    std::vector<UA_ReadValueId> ids;
+    ids.reserve((std::min)(items.size(), maxPerRequest));
+
+    // Schleife: Items in Chunks zu je maxPerRequest NodesToRead aufteilen.
+    for (size_t base = 0; base < items.size(); base += maxPerRequest) {
+        const size_t n = (std::min)(maxPerRequest, items.size() - base);
+        ids.clear();
+        for (size_t i = 0; i < n; ++i) {
+            const auto& it = items[base + i];
+            UA_ReadValueId rv; UA_ReadValueId_init(&rv);
+            // NodeId zeigt nur auf den std::string (kein ALLOC) – Request wird nicht gecleart
+            rv.nodeId      = UA_NODEID_STRING(it.ns, const_cast<char*>(it.id.c_str()));
+            rv.attributeId = UA_ATTRIBUTEID_VALUE;
+            ids.push_back(rv);
+        }
+
+        UA_ReadRequest req; UA_ReadRequest_init(&req);
+        req.nodesToRead        = ids.data();
+        req.nodesToReadSize    = ids.size();
+        req.timestampsToReturn = UA_TIMESTAMPSTORETURN_NEITHER;
+
+        UA_ReadResponse resp = UA_Client_Service_read(client_, req);
+        if (resp.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            allOk = false;
+        } else {
+            const size_t m = (std::min)(n, resp.resultsSize);
+            for (size_t i = 0; i < m; ++i) {
+                const UA_DataValue& dv = resp.results[i];
+                if (!dv.hasValue) continue;
+                if (dv.hasStatus && dv.status != UA_STATUSCODE_GOOD) continue;
+                out[base + i] = variantToUAValue(dv.value);
+            }
+        }
+        UA_ReadResponse_clear(&resp);
+    }
+    return allOk;
+}
+
+// ==== Live-Spiegel ===========================================================
+// Ein Slot je NodeTable-Slot (gleicher Index). Der Spiegel gehört dem UA-Thread: Schreiber
+// ist der DataChange-Callback aus runIterate(), Leser ist buildInventorySnapshotNow (per
+// post() im UA-Thread) – daher ohne Sperren. Aufrufe aus anderen Threads lehnt
+// mirrorValues() ab.
+struct PLCMonitor::MirrorSlot {
+    UAValue     cur, prev;              // monostate = kein (guter) Wert
+    int64_t     curTs = 0, prevTs = 0;  // sourceTimestamp (UA_DateTime); 0 = nie gesehen
+};
+
+void PLCMonitor::mirrorDataChangeHandler(UA_Client*, UA_UInt32, void*,
+                                         UA_UInt32, void* monCtx,
+                                         UA_DataValue* value) {
+    auto* slot = static_cast<MirrorSlot*>(monCtx);
+    if (!slot || !value) return;
+
+    UAValue v;
+    if (value->hasValue && !(value->hasStatus && value->status != UA_STATUSCODE_GOOD))
+        v = variantToUAValue(value->value);
+    const int64_t ts = value->hasSourceTimestamp ? value->sourceTimestamp
+                     : value->hasServerTimestamp ? value->serverTimestamp
+                     : UA_DateTime_now();
+
+    // cur -> prev, neuer Wert -> cur
+    slot->prev   = std::move(slot->cur);
+    slot->prevTs = slot->curTs;
+    slot->cur    = std::move(v);
+    slot->curTs  = ts;
+}
+
+bool PLCMonitor::startValueMirror(NodeTablePtr nodes, double samplingMs, UA_UInt32 queueSize) {
+    if (!client_ || !nodes) return false;
+    stopValueMirror();
+    if (!ensureSubscription()) return false;
+
+    mirSamplingMs_ = samplingMs;
+    mirQueueSize_  = queueSize;
+    mirThread_     = std::this_thread::get_id();   // UA-Thread: einziger Zugriff auf den Spiegel
+
+    // Ein Slot je NodeTable-Slot; danach keine Größenänderung mehr (Adressen = Kontext)
+    mirNodes_ = std::move(nodes);
+    mirSlots_.assign(mirNodes_->size(), MirrorSlot{});
+
+    // MonitoredItems in Blöcken anlegen (ein CreateMonitoredItems-Request je Block)
+    const size_t kChunk = 500;
+    size_t failed = 0;
+    for (size_t base = 0; base < mirSlots_.size(); base += kChunk) {
+        const size_t n = (std::min)(kChunk, mirSlots_.size() - base);
+
+        std::vector<UA_MonitoredItemCreateRequest>            reqs(n);
+        std::vector<void*>                                    ctxs(n);
+        std::vector<UA_Client_DataChangeNotificationCallback> cbs(n, &PLCMonitor::mirrorDataChangeHandler);
+        std::vector<UA_Client_DeleteMonitoredItemCallback>    dels(n, nullptr);
+        for (size_t i = 0; i < n; ++i) {
+            MirrorSlot*    slot = &mirSlots_[base + i];
+            const NodeKey& key  = mirNodes_->keys[base + i];   // Layout enthält nur String-NodeIds
+            reqs[i] = UA_MonitoredItemCreateRequest_default(
+                UA_NODEID_STRING(key.ns, const_cast<char*>(key.id.c_str())));
+            reqs[i].requestedParameters.samplingInterval = samplingMs;
+            reqs[i].requestedParameters.queueSize        = queueSize;
+            reqs[i].requestedParameters.discardOldest    = UA_TRUE;
+            ctxs[i] = slot;
+        }
+
+        UA_CreateMonitoredItemsRequest req; UA_CreateMonitoredItemsRequest_init(&req);
+        req.subscriptionId     = subId_;
+        req.timestampsToReturn = UA_TIMESTAMPSTORETURN_BOTH;
+        req.itemsToCreate      = reqs.data();
+        req.itemsToCreateSize  = n;
+
+        UA_CreateMonitoredItemsResponse resp =
+            UA_Client_MonitoredItems_createDataChanges(client_, req, ctxs.data(),
+                                                       cbs.data(), dels.data());
+        if (resp.responseHeader.serviceResult != UA_STATUSCODE_GOOD) {
+            failed += n;
+        } else {
+            for (size_t i = 0; i < resp.resultsSize; ++i) {
+                if (resp.results[i].statusCode == UA_STATUSCODE_GOOD)
+                    mirMonIds_.push_back(resp.results[i].monitoredItemId);
+                else
+                    ++failed;
+            }
+        }
+        UA_CreateMonitoredItemsResponse_clear(&resp);
+    }
+
+    std::cout << "[Mirror] " << mirMonIds_.size() << " MonitoredItems aktiv"
+              << (failed ? " (" + std::to_string(failed) + " fehlgeschlagen)" : std::string{})
+              << "\n";
+    mirActive_.store(!mirMonIds_.empty(), std::memory_order_release);
+    return !mirMonIds_.empty();
+}
+
+void PLCMonitor::stopValueMirror() {
+    mirActive_.store(false, std::memory_order_release);
+    if (client_ && subId_ && !mirMonIds_.empty()) {
+        UA_DeleteMonitoredItemsRequest req; UA_DeleteMonitoredItemsRequest_init(&req);
+        req.subscriptionId       = subId_;
+        req.monitoredItemIds     = mirMonIds_.data();
+        req.monitoredItemIdsSize = mirMonIds_.size();
+        UA_DeleteMonitoredItemsResponse resp = UA_Client_MonitoredItems_delete(client_, req);
+        UA_DeleteMonitoredItemsResponse_clear(&resp);
+    }
+    mirMonIds_.clear();
+    mirSlots_.clear();
+    mirNodes_.reset();
+}
+
+bool PLCMonitor::mirrorActive() const {
+    return mirActive_.load(std::memory_order_acquire);
+}
+
+bool PLCMonitor::refreshValueMirrorIfStale(const NodeTablePtr& nodes) {
+    if (!mirrorActive() || std::this_thread::get_id() != mirThread_) return false;
+    if (mirNodes_ == nodes) return true;
+    std::cout << "[Mirror] Inventar neu aufgebaut -> Spiegel wird neu aufgesetzt\n";
+    return startValueMirror(nodes, mirSamplingMs_, mirQueueSize_);
+}
+
+UA_UInt64 PLCMonitor::mirrorOffThreadCalls() const {
+    return mirOffThread_.load(std::memory_order_relaxed);
+}
+
+bool PLCMonitor::mirrorValues(const NodeTablePtr& nodes,
+                              std::vector<UAValue>& out,
+                              UA_DateTime atSourceTs,
+                              std::vector<size_t>* missing) const {
+    if (missing) missing->clear();
+    if (!mirrorActive() || !nodes || nodes != mirNodes_) return false;
+    if (std::this_thread::get_id() != mirThread_) {
+        // Normaler Fallback (Aufrufer liest per Batch-Read) – nur zählen, nicht je Snapshot loggen
+        if (mirOffThread_.fetch_add(1, std::memory_order_relaxed) == 0)
+            std::cout << "[Mirror] mirrorValues ausserhalb des UA-Threads -> Batch-Read (weitere nur gezählt)\n";
+        return false;
+    }
+
+    // Schleife: Slot i des Spiegels = Slot i der NodeTable; Wert zur Trigger-Flanke kopieren.
+    out.assign(mirSlots_.size(), UAValue{});
+    for (size_t i = 0; i < mirSlots_.size(); ++i) {
+        const MirrorSlot& s = mirSlots_[i];
+        if (s.curTs == 0) {                       // noch kein Wert (z. B. MonitoredItem fehlgeschlagen)
+            if (missing) missing->push_back(i);
+            continue;
+        }
+
+        // Aktueller Wert jünger als die Flanke: der vorherige galt zur Flanke – aber nur,
+        // wenn er selbst nicht jünger ist. Sonst (zweimal geändert bzw. kein Vorwert) ist der
+        // Stand zur Flanke unbekannt -> missing, der Aufrufer liest nach.
+        if (atSourceTs != 0 && s.curTs > atSourceTs) {
+            if (s.prevTs != 0 && s.prevTs <= atSourceTs) {
+                out[i] = s.prev;
+            } else if (missing) {
+                missing->push_back(i);
+            }
+            continue;
+        }
+        out[i] = s.cur;
+    }
+    return true;
+}
+
 bool PLCMonitor::dumpPlcInventory(std::vector<InventoryRow>& out, const char* plcNameContains) {
     out.clear();
     if (!client_) return false;
@@ -669,6 +894,170 @@ void PLCMonitor::printInventoryTable(const std::vector<InventoryRow>& rows) cons
         std::cout << r.nodeClass << " | " << r.nodeId << " | " << r.dtypeOrSig << "\n";
 }
 
+// ==== Inventory-Cache ========================================================
+void PLCMonitor::invalidateInventoryCache() {
+    std::lock_guard<std::mutex> lk(invmx_);
+    invValid_ = false;
+    invRows_.reset();
+}
+
+UA_UInt64 PLCMonitor::inventoryGeneration() const {
+    std::lock_guard<std::mutex> lk(invmx_);
+    return invGeneration_;
+}
+
+bool PLCMonitor::inventoryCached(InventoryRowsPtr& out, const char* plcNameContains) {
+    const std::string root = plcNameContains ? plcNameContains : "PLC";
+
+    // Treffer: nur Flag + Root vergleichen, kein Read (Invalidierung kommt über die Subscription)
+    {
+        std::lock_guard<std::mutex> lk(invmx_);
+        const bool dirty = invDirty_.exchange(false, std::memory_order_acq_rel);
+        if (invValid_ && !dirty && invRoot_ == root) {
+            out = invRows_;
+            return true;
+        }
+        if (invValid_)
+            std::cout << "[Inventory] Cache verworfen ("
+                      << (dirty ? "Modelländerung" : "anderer root")
+                      << ") -> neuer Browse\n";
+    }
+
+    auto rows = std::make_shared<InventoryRows>();
+    if (!dumpPlcInventory(*rows, root.c_str())) {
+        invalidateInventoryCache();
+        out.reset();
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lk(invmx_);
+    invRows_  = std::move(rows);
+    invRoot_  = root;
+    invValid_ = true;
+    ++invGeneration_;
+    out = invRows_;
+    return true;
+}
+
+bool PLCMonitor::watchModelChanges() {
+    if (!client_) return false;
+    if (monIdModelChange_) return true;
+    if (!ensureSubscription()) return false;
+
+    // SelectClause: nur EventType – der Typ entscheidet im Handler über die Invalidierung
+    UA_QualifiedName qn = UA_QUALIFIEDNAME(0, const_cast<char*>("EventType"));
+    UA_SimpleAttributeOperand sel; UA_SimpleAttributeOperand_init(&sel);
+    sel.typeDefinitionId = UA_NODEID_NUMERIC(0, UA_NS0ID_BASEEVENTTYPE);
+    sel.browsePathSize   = 1;
+    sel.browsePath       = &qn;
+    sel.attributeId      = UA_ATTRIBUTEID_VALUE;
+
+    UA_EventFilter filter; UA_EventFilter_init(&filter);
+    filter.selectClauses     = &sel;
+    filter.selectClausesSize = 1;
+
+    UA_MonitoredItemCreateRequest item; UA_MonitoredItemCreateRequest_init(&item);
+    item.itemToMonitor.nodeId      = UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER);
+    item.itemToMonitor.attributeId = UA_ATTRIBUTEID_EVENTNOTIFIER;
+    item.monitoringMode            = UA_MONITORINGMODE_REPORTING;
+    item.requestedParameters.filter.encoding             = UA_EXTENSIONOBJECT_DECODED;
+    item.requestedParameters.filter.content.decoded.data = &filter;
+    item.requestedParameters.filter.content.decoded.type = &UA_TYPES[UA_TYPES_EVENTFILTER];
+    item.requestedParameters.queueSize     = 10;
+    item.requestedParameters.discardOldest = UA_TRUE;
+
+    UA_MonitoredItemCreateResult res =
+        UA_Client_MonitoredItems_createEvent(client_, subId_, UA_TIMESTAMPSTORETURN_BOTH,
+                                             item, this, &PLCMonitor::modelChangeEventHandler,
+                                             nullptr);
+    if (res.statusCode != UA_STATUSCODE_GOOD) {
+        std::cout << "[Inventory] ModelChange-Abo nicht möglich: "
+                  << UA_StatusCode_name(res.statusCode) << "\n";
+        UA_MonitoredItemCreateResult_clear(&res);
+        return false;
+    }
+    monIdModelChange_ = res.monitoredItemId;
+    UA_MonitoredItemCreateResult_clear(&res);
+
+    // Versionsmarken: nicht jeder Server meldet Downloads als ModelChange-Event
+    (void)watchVersionNode_(UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER_NAMESPACEARRAY), verWatch_[0]);
+    if (!opt_.modelVersionNodeId.empty()) {
+        uint16_t ns = 0; std::string id; char t = 0;
+        if (parseNsAndId(opt_.modelVersionNodeId, ns, id, t) && t == 's')
+            (void)watchVersionNode_(UA_NODEID_STRING(ns, const_cast<char*>(id.c_str())), verWatch_[1]);
+        else
+            std::cout << "[Inventory] modelVersionNodeId '" << opt_.modelVersionNodeId
+                      << "' nicht unterstützt (nur ns=..;s=..)\n";
+    }
+    return true;
+}
+
+bool PLCMonitor::watchVersionNode_(const UA_NodeId& node, VersionWatch& w) {
+    w.self = this;
+    w.seen = false;
+    UA_Variant_clear(&w.last);
+
+    UA_MonitoredItemCreateRequest item = UA_MonitoredItemCreateRequest_default(node);
+    item.requestedParameters.queueSize     = 1;
+    item.requestedParameters.discardOldest = UA_TRUE;
+
+    UA_MonitoredItemCreateResult res =
+        UA_Client_MonitoredItems_createDataChange(client_, subId_, UA_TIMESTAMPSTORETURN_NEITHER,
+                                                  item, &w, &PLCMonitor::versionChangeHandler,
+                                                  nullptr);
+    const bool ok = (res.statusCode == UA_STATUSCODE_GOOD);
+    if (ok) w.monId = res.monitoredItemId;
+    else std::cout << "[Inventory] Versions-Abo nicht möglich: " << UA_StatusCode_name(res.statusCode) << "\n";
+    UA_MonitoredItemCreateResult_clear(&res);
+    return ok;
+}
+
+void PLCMonitor::clearVersionWatches_() {
+    for (auto& w : verWatch_) {
+        w.monId = 0;
+        w.seen  = false;
+        UA_Variant_clear(&w.last);
+    }
+}
+
+void PLCMonitor::versionChangeHandler(UA_Client*, UA_UInt32, void*,
+                                      UA_UInt32, void* monCtx, UA_DataValue* value) {
+    auto* w = static_cast<VersionWatch*>(monCtx);
+    if (!w || !w->self || !value || !value->hasValue) return;
+    if (w->seen && UA_order(&w->last, &value->value, &UA_TYPES[UA_TYPES_VARIANT]) == UA_ORDER_EQ)
+        return;
+
+    const bool changed = w->seen;   // erster Wert = Stand beim Abo, keine Änderung
+    UA_Variant_clear(&w->last);
+    UA_Variant_copy(&value->value, &w->last);
+    w->seen = true;
+    if (changed) {
+        std::cout << "[Inventory] Modellversion geändert -> Cache invalidiert\n";
+        w->self->invDirty_.store(true, std::memory_order_release);
+    }
+}
+
+void PLCMonitor::modelChangeEventHandler(UA_Client*, UA_UInt32, void* subCtx,
+                                         UA_UInt32, void* monCtx,
+                                         size_t nEventFields, UA_Variant* eventFields) {
+    PLCMonitor* self = static_cast<PLCMonitor*>(monCtx ? monCtx : subCtx);
+    if (!self || nEventFields < 1 || !eventFields) return;
+
+    const UA_Variant& f = eventFields[0];
+    if (!UA_Variant_isScalar(&f) || f.type != &UA_TYPES[UA_TYPES_NODEID] || !f.data) return;
+    const UA_NodeId* et = static_cast<const UA_NodeId*>(f.data);
+
+    const bool modelChange =
+        et->namespaceIndex == 0 && et->identifierType == UA_NODEIDTYPE_NUMERIC &&
+        (et->identifier.numeric == UA_NS0ID_BASEMODELCHANGEEVENTTYPE    ||
+         et->identifier.numeric == UA_NS0ID_GENERALMODELCHANGEEVENTTYPE ||
+         et->identifier.numeric == UA_NS0ID_SEMANTICCHANGEEVENTTYPE);
+    if (modelChange) {
+        std::cout << "[Inventory] ModelChange-Event empfangen -> Cache invalidiert\n";
+        self->invDirty_.store(true, std::memory_order_release);
+    }
+}
+
 
 // ==== PLCMonitor – Basics ====================================================
 PLCMonitor::PLCMonitor(Options o) : opt_(std::move(o)) {}
@@ -724,28 +1113,64 @@ bool PLCMonitor::connect() {
         return false;
     }
 
+    // Weckrufe für runOnce() ab jetzt über den EventLoop des Clients
+    {
+        std::lock_guard<std::mutex> lk(wakemx_);
+        wakeDc_ = UA_DelayedCallback{};
+        wakeDc_.callback    = &PLCMonitor::wakeCb_;
+        wakeDc_.application = this;
+        wakeDcQueued_.store(false, std::memory_order_release);
+        wakeEl_ = cfg->eventLoop;
+    }
+
     if(!waitUntilActivated(3000)) {
         UA_LOG_WARNING(UA_Log_Stdout, UA_LOGCATEGORY_CLIENT,
                        "Session not ACTIVATED within timeout");
         disconnect();
         return false;
     }
+
+    // Inventory einmalig beim Connect aufbauen; Trigger lesen danach nur noch Werte.
+    (void)watchModelChanges();
+    {
+        InventoryRowsPtr rows;
+        (void)inventoryCached(rows, "PLC");
+    }
     return true;
 }
 
 void PLCMonitor::disconnect() {
     if(client_) {
+        // Noch nicht gesendete Aufrufe abbrechen; laufende meldet der Client beim Disconnect
+        callsClosing_ = true;
+        while (!callPending_.empty()) {
+            auto c = std::move(callPending_.front());
+            callPending_.pop_front();
+            c->fail(UA_STATUSCODE_BADSHUTDOWN);
+        }
+        stopValueMirror();
         if(subId_) {
             UA_Client_Subscriptions_deleteSingle(client_, subId_);
             subId_ = 0; monIdInt16_ = 0; monIdBool_ = 0;
         }
+        monIdModelChange_ = 0;
+        clearVersionWatches_();
+        invalidateInventoryCache();   // nach Reconnect immer frisch browsen
+        {
+            std::lock_guard<std::mutex> lk(wakemx_);
+            wakeEl_ = nullptr;        // keine neuen Weckrufe in den EventLoop
+        }
         UA_Client_disconnect(client_);
         UA_Client_delete(client_);
         client_ = nullptr;
+        callsClosing_ = false;
     }
     running_.store(false, std::memory_order_release);
     { std::lock_guard<std::mutex> lk(qmx_); while(!q_.empty()) q_.pop(); }
-    { std::lock_guard<std::mutex> lk(tmx_); timers_.clear(); }
+    // Verworfene Timer: onDrop-Callbacks (z. B. Plan-Continuations) ohne Lock abschließen
+    std::vector<UaFn> dropped;
+    { std::lock_guard<std::mutex> lk(tmx_); timers_.clear(&dropped); }
+    for (auto& f : dropped) f();
 }
 
 UA_StatusCode PLCMonitor::runIterate(int timeoutMs) {
@@ -814,22 +1239,29 @@ bool PLCMonitor::writeBool(const std::string& nodeIdStr, UA_UInt16 ns, bool valu
 }
 
 // ==== Subscriptions ==========================================================
+bool PLCMonitor::ensureSubscription() {
+    if(!client_) return false;
+    if(subId_ != 0) return true;
+
+    UA_CreateSubscriptionRequest sReq = UA_CreateSubscriptionRequest_default();
+    sReq.requestedPublishingInterval = 20.0;
+    sReq.requestedMaxKeepAliveCount  = 20;
+    sReq.requestedLifetimeCount      = 60;
+
+    UA_CreateSubscriptionResponse sResp =
+        UA_Client_Subscriptions_create(client_, sReq, /*subCtx*/this, nullptr, nullptr);
+    if(sResp.responseHeader.serviceResult != UA_STATUSCODE_GOOD)
+        return false;
+    subId_ = sResp.subscriptionId;
+    return true;
+}
+
 bool PLCMonitor::subscribeInt16(const std::string& nodeIdStr, UA_UInt16 nsIndex,
                                 double samplingMs, UA_UInt32 queueSize, Int16ChangeCallback cb) {
     if(!client_) return false;
     onInt16Change_ = std::move(cb);
 
-    if(subId_ == 0) {
-        UA_CreateSubscriptionRequest sReq = UA_CreateSubscriptionRequest_default();
-        sReq.requestedPublishingInterval = 20.0;
-        sReq.requestedMaxKeepAliveCount  = 20;
-        sReq.requestedLifetimeCount      = 60;
-
-        UA_CreateSubscriptionResponse sResp =
-            UA_Client_Subscriptions_create(client_, sReq, /*subCtx*/this, nullptr, nullptr);
-        if(sResp.responseHeader.serviceResult != UA_STATUSCODE_GOOD) return false;
-        subId_ = sResp.subscriptionId;
-    }
+    if(!ensureSubscription()) return false;
 
     UA_MonitoredItemCreateRequest monReq =
         UA_MonitoredItemCreateRequest_default(
@@ -854,18 +1286,7 @@ bool PLCMonitor::subscribeBool(const std::string& nodeIdStr, UA_UInt16 nsIndex,
                                double samplingMs, UA_UInt32 queueSize, BoolChangeCallback cb) {
     if(!client_) return false;
 
-    if(subId_ == 0) {
-        UA_CreateSubscriptionRequest sReq = UA_CreateSubscriptionRequest_default();
-        sReq.requestedPublishingInterval = 20.0;
-        sReq.requestedMaxKeepAliveCount  = 20;
-        sReq.requestedLifetimeCount      = 60;
-
-        UA_CreateSubscriptionResponse sResp =
-            UA_Client_Subscriptions_create(client_, sReq, /*subCtx*/this, nullptr, nullptr);
-        if(sResp.responseHeader.serviceResult != UA_STATUSCODE_GOOD)
-            return false;
-        subId_ = sResp.subscriptionId;
-    }
+    if(!ensureSubscription()) return false;
 
     UA_MonitoredItemCreateRequest monReq =
         UA_MonitoredItemCreateRequest_default(
@@ -892,12 +1313,14 @@ bool PLCMonitor::subscribeBool(const std::string& nodeIdStr, UA_UInt16 nsIndex,
 }
 
 void PLCMonitor::unsubscribe() {
+    stopValueMirror();
     if(client_ && subId_) {
         UA_Client_Subscriptions_deleteSingle(client_, subId_);
     }
     subId_ = 0;
     monIdInt16_ = 0;
     monIdBool_  = 0;
+    monIdModelChange_ = 0;
     onInt16Change_ = nullptr;
     onBoolChange_  = nullptr;
     {
@@ -945,8 +1368,11 @@ void PLCMonitor::dataChangeHandler(UA_Client*,
 
 // ==== Task-Queue =============================================================
 void PLCMonitor::post(UaFn fn) {
-    std::lock_guard<std::mutex> lk(qmx_);
-    q_.push(std::move(fn));
+    {
+        std::lock_guard<std::mutex> lk(qmx_);
+        q_.push(std::move(fn));
+    }
+    wakeup();
 }
 void PLCMonitor::processPosted(size_t max) {
     processTimers();
@@ -957,29 +1383,98 @@ void PLCMonitor::processPosted(size_t max) {
           fn = std::move(q_.front()); q_.pop(); }
         fn(); // läuft im gleichen Thread, in dem du runIterate() aufrufst
     }
-    // ggf. neu fällig gewordene Timer nachziehen
+    // ggf. neu fällig gewordene Timer nachziehen (billig, wenn nichts fällig ist)
     processTimers();
 }
-void PLCMonitor::postDelayed(int delayMs, UaFn fn) {
-    auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds(delayMs);
+PLCMonitor::TimerId PLCMonitor::postDelayed(int delayMs, UaFn fn, UaFn onDrop) {
+    // Deadline aufrunden: der Timer läuft nie vor Ablauf von delayMs
+    const auto due = std::chrono::steady_clock::now() + std::chrono::milliseconds((std::max)(0, delayMs));
+    const auto tick = std::chrono::ceil<std::chrono::milliseconds>(due - timerEpoch_).count();
+    TimerId id = 0;
+    {
+        std::lock_guard<std::mutex> lk(tmx_);
+        id = timers_.schedule(static_cast<TimerWheel::Tick>(tick), std::move(fn), std::move(onDrop));
+    }
+    wakeup();   // Loop-Timeout auf die neue Deadline verkürzen
+    return id;
+}
+
+bool PLCMonitor::cancelDelayed(TimerId id) {
     std::lock_guard<std::mutex> lk(tmx_);
-    timers_.push_back(TimedFn{due, std::move(fn)});
+    return timers_.cancel(id);
+}
+
+std::optional<std::chrono::steady_clock::time_point> PLCMonitor::nextTimerDeadline() {
+    std::lock_guard<std::mutex> lk(tmx_);
+    const auto t = timers_.nextDue();
+    if (!t) return std::nullopt;
+    return timerEpoch_ + std::chrono::milliseconds(*t);
+}
+
+int PLCMonitor::msUntilNextTimer(int capMs) {
+    const auto next = nextTimerDeadline();
+    if (!next) return capMs;
+    const auto now = std::chrono::steady_clock::now();
+    if (*next <= now) return 0;
+    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(*next - now).count();
+    return static_cast<int>((std::min)(static_cast<long long>(capMs), static_cast<long long>(ms)));
+}
+
+// ==== Reactor-Loop ===========================================================
+// Weckruf: wakeDc_ wird höchstens einmal gleichzeitig in den EventLoop eingehängt (die
+// Liste verkettet das Objekt selbst); der EventLoop unterbricht dafür sein Warten und
+// ruft wakeCb_ im UA-Thread auf.
+void PLCMonitor::wakeup() {
+    if (wakePending_.exchange(true, std::memory_order_acq_rel)) return;   // steht schon aus
+    {
+        std::lock_guard<std::mutex> lk(wakemx_);
+        if (wakeEl_ && !wakeDcQueued_.exchange(true, std::memory_order_acq_rel))
+            wakeEl_->addDelayedCallback(wakeEl_, &wakeDc_);
+    }
+    wakecv_.notify_one();
+}
+
+void PLCMonitor::wakeCb_(void* application, void* /*context*/) {
+    auto* self = static_cast<PLCMonitor*>(application);
+    self->wakeDcQueued_.store(false, std::memory_order_release);
+}
+
+UA_StatusCode PLCMonitor::runOnce(int maxWaitMs) {
+    int waitMs = (std::max)(0, maxWaitMs);
+    {
+        std::lock_guard<std::mutex> lk(qmx_);
+        if (!q_.empty()) waitMs = 0;
+    }
+    if (waitMs > 0) waitMs = msUntilNextTimer(waitMs);
+
+    UA_StatusCode st = UA_STATUSCODE_GOOD;
+    if (client_) {
+        st = UA_Client_run_iterate(client_, static_cast<UA_UInt32>(waitMs));
+    } else if (waitMs > 0) {
+        std::unique_lock<std::mutex> lk(wakemx_);
+        wakecv_.wait_for(lk, std::chrono::milliseconds(waitMs),
+                         [&]{ return wakePending_.load(std::memory_order_acquire); });
+    }
+    // Ab hier eingehende post()-Aufrufe wecken den nächsten Durchlauf erneut
+    wakePending_.store(false, std::memory_order_release);
+
+    // Alles bis jetzt Gepostete abarbeiten; währenddessen Gepostetes folgt im nächsten Durchlauf
+    size_t n = 0;
+    {
+        std::lock_guard<std::mutex> lk(qmx_);
+        n = q_.size();
+    }
+    processPosted(n);
+    return st;
 }
 
 void PLCMonitor::processTimers() {
     std::vector<UaFn> dueFns;
     {
         std::lock_guard<std::mutex> lk(tmx_);
-        const auto now = std::chrono::steady_clock::now();
-        auto it = timers_.begin();
-        while (it != timers_.end()) {
-            if (it->due <= now) {
-                dueFns.push_back(std::move(it->fn));
-                it = timers_.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        const auto now = std::chrono::floor<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - timerEpoch_).count();
+        timers_.advance(static_cast<TimerWheel::Tick>(now), dueFns);
     }
     for (auto &f : dueFns) f();
 }
@@ -1018,109 +1513,240 @@ bool PLCMonitor::watchTriggerD2(double samplingMs, UA_UInt32 queueSize) {
 
 //== Job Method Call ========================================================
 
-bool PLCMonitor::callMethodTyped(const std::string& objNodeId,
+// ==== Methodenaufrufe (asynchron über den Call-Service) =======================
+namespace {
+
+// UAValueMap (index -> Wert) in Variant-Array; in[] Größe = maxIndex+1, Lücken bleiben leer.
+std::vector<UA_Variant> toCallInputs(const UAValueMap& inputs) {
+    const size_t inSz = inputs.empty() ? 0u : static_cast<size_t>(inputs.rbegin()->first + 1);
+    std::vector<UA_Variant> in(inSz);
+    for (auto& v : in) UA_Variant_init(&v);
+
+    for (auto& [i, val] : inputs) {
+        switch (val.index()) {
+          case 1: { // bool
+            UA_Boolean b = std::get<bool>(val) ? UA_TRUE : UA_FALSE;
+            UA_Variant_setScalarCopy(&in[i], &b, &UA_TYPES[UA_TYPES_BOOLEAN]); break;
+          }
+          case 2: { // int16
+            UA_Int16 x = std::get<int16_t>(val);
+            UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_INT16]); break;
+          }
+          case 3: { // int32
+            UA_Int32 x = std::get<int32_t>(val);
+            UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_INT32]); break;
+          }
+          case 4: { // float
+            UA_Float x = std::get<float>(val);
+            UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_FLOAT]); break;
+          }
+          case 5: { // double
+            UA_Double x = std::get<double>(val);
+            UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_DOUBLE]); break;
+          }
+          case 6: { // string
+            const std::string& s = std::get<std::string>(val);
+            UA_String ua = UA_String_fromChars(s.c_str());
+            UA_Variant_setScalarCopy(&in[i], &ua, &UA_TYPES[UA_TYPES_STRING]);
+            UA_String_clear(&ua);
+            break;
+          }
+          default: break; // monostate -> lässt Slot leer
+        }
+    }
+    return in;
+}
+
+// Skalare Output-Argumente -> UAValueMap (index -> Wert); nicht abgebildete Typen fehlen.
+UAValueMap fromCallOutputs(const UA_Variant* out, size_t outSz) {
+    UAValueMap m;
+    for (size_t i = 0; i < outSz; ++i) {
+        const UA_Variant &vi = out[i];
+        if (!UA_Variant_isScalar(&vi) || !vi.type || !vi.data) continue;
+
+        if (vi.type == &UA_TYPES[UA_TYPES_BOOLEAN]) {
+            m[(int)i] = (*static_cast<UA_Boolean*>(vi.data) == UA_TRUE);
+        } else if (vi.type == &UA_TYPES[UA_TYPES_INT16]) {
+            m[(int)i] = *static_cast<UA_Int16*>(vi.data);
+        } else if (vi.type == &UA_TYPES[UA_TYPES_INT32]) {
+            m[(int)i] = *static_cast<UA_Int32*>(vi.data);
+        } else if (vi.type == &UA_TYPES[UA_TYPES_FLOAT]) {
+            m[(int)i] = *static_cast<UA_Float*>(vi.data);
+        } else if (vi.type == &UA_TYPES[UA_TYPES_DOUBLE]) {
+            m[(int)i] = *static_cast<UA_Double*>(vi.data);
+        } else if (vi.type == &UA_TYPES[UA_TYPES_STRING]) {
+            const UA_String* s = static_cast<UA_String*>(vi.data);
+            m[(int)i] = std::string((char*)s->data, s->length); // UA_String ist NICHT nullterminiert
+        } else {
+            // TODO: weitere Typen bei Bedarf
+        }
+    }
+    return m;
+}
+
+} // namespace
+
+// Ein ausstehender CallRequest (1..n Methoden); gehört bis zur Antwort dem Client (userdata).
+struct PLCMonitor::AsyncCall {
+    PLCMonitor*           self = nullptr;
+    std::vector<CallSpec> calls;
+    unsigned              timeoutMs = 0;
+    BatchCallback         cb;
+
+    // Alle Methoden mit demselben Status melden (Senden fehlgeschlagen, Disconnect, …)
+    void fail(UA_StatusCode st) {
+        std::vector<CallResult> res(calls.size());
+        for (auto& r : res) r.status = st;
+        try { cb(std::move(res)); } catch (...) {}
+    }
+};
+
+void PLCMonitor::callMethodAsync(const std::string& objNodeId,
                                  const std::string& methNodeId,
                                  const UAValueMap& inputs,
-                                 UAValueMap& outputs,
-                                 unsigned timeoutMs)
+                                 unsigned timeoutMs,
+                                 CallCallback cb)
 {
-    std::mutex m; std::condition_variable cv;
-    bool done=false, ok=false;
-    UAValueMap tmpOut;
+    callMethodsAsync({ CallSpec{ objNodeId, methNodeId, inputs } }, timeoutMs,
+        [cb = std::move(cb)](std::vector<CallResult> res) {
+            if (res.empty()) { cb(UA_STATUSCODE_BADUNEXPECTEDERROR, {}); return; }
+            cb(res[0].status, std::move(res[0].outputs));
+        });
+}
 
-    post([&, objNodeId, methNodeId, timeoutMs]{
-        UA_NodeId obj  = UA_NODEID_STRING_ALLOC(opt_.nsIndex, const_cast<char*>(objNodeId.c_str()));
-        UA_NodeId meth = UA_NODEID_STRING_ALLOC(opt_.nsIndex, const_cast<char*>(methNodeId.c_str()));
+void PLCMonitor::callMethodsAsync(std::vector<CallSpec> calls, unsigned timeoutMs, BatchCallback cb) {
+    auto c = std::make_unique<AsyncCall>();
+    c->self      = this;
+    c->calls     = std::move(calls);
+    c->timeoutMs = timeoutMs;
+    c->cb        = std::move(cb);
+
+    // Alles Weitere im UA-Thread: Limit prüfen, ggf. einreihen, sonst Request abschicken
+    post([this, c = std::move(c)]() mutable {
+        const unsigned limit = (std::max)(opt_.maxConcurrentCalls, 1u);
+        if (callsInFlight_ >= limit) { callPending_.push_back(std::move(c)); return; }
+        startCall_(std::move(c));
+    });
+}
 
-        // Inputs: in[] Größe = maxIndex+1
-        size_t inSz = inputs.empty() ? 0u : static_cast<size_t>(inputs.rbegin()->first + 1);
-        std::vector<UA_Variant> in(inSz);
-        for (auto& v : in) UA_Variant_init(&v);
-
-        for (auto& [i, val] : inputs) {
-            switch (val.index()) {
-              case 1: { // bool
-                UA_Boolean b = std::get<bool>(val) ? UA_TRUE : UA_FALSE;
-                UA_Variant_setScalarCopy(&in[i], &b, &UA_TYPES[UA_TYPES_BOOLEAN]); break;
-              }
-              case 2: { // int16
-                UA_Int16 x = std::get<int16_t>(val);
-                UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_INT16]); break;
-              }
-              case 3: { // int32
-                UA_Int32 x = std::get<int32_t>(val);
-                UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_INT32]); break;
-              }
-              case 4: { // float
-                UA_Float x = std::get<float>(val);
-                UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_FLOAT]); break;
-              }
-              case 5: { // double
-                UA_Double x = std::get<double>(val);
-                UA_Variant_setScalarCopy(&in[i], &x, &UA_TYPES[UA_TYPES_DOUBLE]); break;
-              }
-              case 6: { // string
-                std::string s = std::get<std::string>(val);
-                UA_String ua = UA_String_fromChars(s.c_str());
-                UA_Variant_setScalarCopy(&in[i], &ua, &UA_TYPES[UA_TYPES_STRING]);
-                UA_String_clear(&ua);
-                break;
-              }
-              default: break; // monostate -> lässt Slot leer
-            }
-        }
+void PLCMonitor::startCall_(std::unique_ptr<AsyncCall> c) {
+    if (!client_) { c->fail(UA_STATUSCODE_BADSERVERNOTCONNECTED); return; }
+    if (c->calls.empty()) { c->fail(UA_STATUSCODE_GOOD); return; }
+
+    // Ein CallMethodRequest je Methode, alle in einem UA_CallRequest
+    const size_t n = c->calls.size();
+    std::vector<std::vector<UA_Variant>> ins(n);
+    std::vector<UA_CallMethodRequest>    items(n);
+    for (size_t i = 0; i < n; ++i) {
+        const CallSpec& cs = c->calls[i];
+        ins[i] = toCallInputs(cs.inputs);
+        UA_CallMethodRequest_init(&items[i]);
+        items[i].objectId           = UA_NODEID_STRING_ALLOC(opt_.nsIndex, const_cast<char*>(cs.objNodeId.c_str()));
+        items[i].methodId           = UA_NODEID_STRING_ALLOC(opt_.nsIndex, const_cast<char*>(cs.methNodeId.c_str()));
+        items[i].inputArgumentsSize = ins[i].size();
+        items[i].inputArguments     = ins[i].data();
+    }
 
-        // Timeout temporär setzen und Call ausführen
-        UA_ClientConfig *cfg = UA_Client_getConfig(client_);
-        UA_UInt32 oldTo = cfg->timeout;
-        cfg->timeout = timeoutMs;
+    UA_CallRequest req;
+    UA_CallRequest_init(&req);
+    req.methodsToCallSize = n;
+    req.methodsToCall     = items.data();
+
+    // Request wird sofort kodiert/gesendet; Timeout je Request statt cfg->timeout umzubiegen
+    AsyncCall* raw = c.release();
+    ++callsInFlight_;
+    UA_UInt32 reqId = 0;
+    const UA_StatusCode st = __UA_Client_AsyncServiceEx(
+        client_, &req, &UA_TYPES[UA_TYPES_CALLREQUEST],
+        &PLCMonitor::asyncCallDone_, &UA_TYPES[UA_TYPES_CALLRESPONSE],
+        raw, &reqId, raw->timeoutMs);
+
+    for (size_t i = 0; i < n; ++i) {
+        for (auto& v : ins[i]) UA_Variant_clear(&v);
+        UA_NodeId_clear(&items[i].objectId);
+        UA_NodeId_clear(&items[i].methodId);
+    }
 
-        size_t outSz = 0; UA_Variant* out = nullptr;
-        UA_StatusCode st = UA_Client_call(client_, obj, meth, inSz, in.data(), &outSz, &out); // offizielle API. :contentReference[oaicite:2]{index=2}
+    if (st != UA_STATUSCODE_GOOD) {
+        // Senden fehlgeschlagen -> Callback kommt nicht vom Client, selbst melden
+        --callsInFlight_;
+        std::unique_ptr<AsyncCall> back(raw);
+        std::cerr << "[PLCMonitor] callMethodsAsync send failed: " << UA_StatusCode_name(st) << "\n";
+        back->fail(st);
+        startPendingCalls_();
+    }
+}
 
-        cfg->timeout = oldTo;
-        for (auto& v : in) UA_Variant_clear(&v);
+void PLCMonitor::asyncCallDone_(UA_Client*, void* userdata, UA_UInt32, void* response) {
+    std::unique_ptr<AsyncCall> c(static_cast<AsyncCall*>(userdata));
+    PLCMonitor* self = c->self;
+    --self->callsInFlight_;
 
-        if (st == UA_STATUSCODE_GOOD) {
-            ok = true;
-            for (size_t i = 0; i < outSz; ++i) {
-                const UA_Variant &vi = out[i];
-                if (!UA_Variant_isScalar(&vi) || !vi.type || !vi.data) continue; // Absicherung. :contentReference[oaicite:3]{index=3}
-
-                if (vi.type == &UA_TYPES[UA_TYPES_BOOLEAN]) {
-                    tmpOut[(int)i] = (*static_cast<UA_Boolean*>(vi.data) == UA_TRUE);
-                } else if (vi.type == &UA_TYPES[UA_TYPES_INT16]) {
-                    tmpOut[(int)i] = *static_cast<UA_Int16*>(vi.data);
-                } else if (vi.type == &UA_TYPES[UA_TYPES_INT32]) {
-                    tmpOut[(int)i] = *static_cast<UA_Int32*>(vi.data);
-                } else if (vi.type == &UA_TYPES[UA_TYPES_FLOAT]) {
-                    tmpOut[(int)i] = *static_cast<UA_Float*>(vi.data);
-                } else if (vi.type == &UA_TYPES[UA_TYPES_DOUBLE]) {
-                    tmpOut[(int)i] = *static_cast<UA_Double*>(vi.data);
-                } else if (vi.type == &UA_TYPES[UA_TYPES_STRING]) {
-                    const UA_String* s = static_cast<UA_String*>(vi.data);
-                    std::string cpp((char*)s->data, s->length); // UA_String ist NICHT nullterminiert. :contentReference[oaicite:4]{index=4}
-                    tmpOut[(int)i] = std::move(cpp);
-                } else {
-                    // TODO: weitere Typen bei Bedarf
-                }
-            }
+    const auto* r = static_cast<const UA_CallResponse*>(response);
+    const UA_StatusCode svc = r ? r->responseHeader.serviceResult : UA_STATUSCODE_BADINTERNALERROR;
+    if (svc != UA_STATUSCODE_GOOD) {
+        c->fail(svc);
+    } else {
+        // results[i] gehört zu calls[i]; fehlende Einträge gelten als Fehler
+        std::vector<CallResult> res(c->calls.size());
+        for (size_t i = 0; i < res.size(); ++i) {
+            if (i >= r->resultsSize) { res[i].status = UA_STATUSCODE_BADUNEXPECTEDERROR; continue; }
+            res[i].status = r->results[i].statusCode;
+            if (res[i].status == UA_STATUSCODE_GOOD)
+                res[i].outputs = fromCallOutputs(r->results[i].outputArguments,
+                                                 r->results[i].outputArgumentsSize);
         }
+        try { c->cb(std::move(res)); }
+        catch (const std::exception& e) { std::cerr << "[PLCMonitor] call callback failed: " << e.what() << "\n"; }
+        catch (...) { std::cerr << "[PLCMonitor] call callback failed (unknown)\n"; }
+    }
 
-        if (out) UA_Array_delete(out, outSz, &UA_TYPES[UA_TYPES_VARIANT]);
-        UA_NodeId_clear(&obj);
-        UA_NodeId_clear(&meth);
+    self->startPendingCalls_();
+}
 
-        { std::lock_guard<std::mutex> lk(m); done = true; }
-        cv.notify_one();
-    });
+void PLCMonitor::startPendingCalls_() {
+    if (callsClosing_) return;   // Disconnect läuft: Client nimmt keine Requests mehr an
+    const unsigned limit = (std::max)(opt_.maxConcurrentCalls, 1u);
+    while (!callPending_.empty() && callsInFlight_ < limit) {
+        auto c = std::move(callPending_.front());
+        callPending_.pop_front();
+        startCall_(std::move(c));
+    }
+}
 
-    std::unique_lock<std::mutex> lk(m);
-    if (cv.wait_for(lk, std::chrono::milliseconds(timeoutMs + 500)) == std::cv_status::timeout)
+bool PLCMonitor::callMethodsTyped(const std::vector<CallSpec>& calls,
+                                  std::vector<CallResult>& results,
+                                  unsigned timeoutMs)
+{
+    // Ergebnis über geteilten Zustand: kommt die Antwort nach unserem Timeout, schreibt der
+    // Callback in das noch lebende promise statt in einen abgebauten Stack-Frame.
+    auto prom = std::make_shared<std::promise<std::vector<CallResult>>>();
+    auto fut  = prom->get_future();
+
+    callMethodsAsync(calls, timeoutMs,
+        [prom](std::vector<CallResult> res) { prom->set_value(std::move(res)); });
+
+    // Reserve für Warteschlange (Call-Limit) und Weiterleitung im UA-Thread
+    if (fut.wait_for(std::chrono::milliseconds(timeoutMs + 500)) != std::future_status::ready) {
+        results.assign(calls.size(), CallResult{ UA_STATUSCODE_BADTIMEOUT, {} });
         return false;
+    }
 
-    if (ok) outputs = std::move(tmpOut);
-    return ok;
+    results = fut.get();
+    return std::all_of(results.begin(), results.end(),
+                       [](const CallResult& r){ return r.status == UA_STATUSCODE_GOOD; });
+}
+
+bool PLCMonitor::callMethodTyped(const std::string& objNodeId,
+                                 const std::string& methNodeId,
+                                 const UAValueMap& inputs,
+                                 UAValueMap& outputs,
+                                 unsigned timeoutMs)
+{
+    std::vector<CallResult> res;
+    if (!callMethodsTyped({ CallSpec{ objNodeId, methNodeId, inputs } }, res, timeoutMs)) return false;
+    outputs = std::move(res[0].outputs);
+    return true;
 }
 
 bool PLCMonitor::callJob(const std::string& objNodeId,
@@ -0,0 +1,203 @@
+// PlanExecutor.cpp
+// Gruppenweise Ausführung: Barriere zwischen Schrittgruppen, innerhalb einer Gruppe
+// Worker per std::async, die sich Schritte über einen atomaren Index holen. Die
+// asynchrone Variante treibt denselben Ablauf über Rückmeldungen der Schritte an.
+#include "PlanExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point t0, Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(t - t0).count();
+}
+
+// Zustand von executeStepGroupsAsync; Rückmeldungen kommen aus beliebigen Threads
+struct AsyncGroupRun {
+    std::shared_ptr<const Plan>        plan;
+    AsyncStepFn                        step;
+    AsyncPrepareFn                     prepare;
+    size_t                             maxParallel = 1;
+    std::function<void(PlanRunReport)> done;
+
+    std::mutex        mx;
+    PlanRunReport     rep;
+    Clock::time_point t0, gStart;
+    size_t groups  = 0;          // begonnene Gruppen
+    size_t b = 0, e = 0;         // aktuelle Gruppe [b, e)
+    size_t next    = 0;          // nächster zu startender Schritt
+    size_t running = 0;          // gestartet, fin(...) steht aus
+    bool preparing = false;      // wartet auf go()
+    bool pumping   = false;      // ein Thread treibt gerade an (Rückmeldungen nur vermerken)
+};
+
+void pumpGroups(const std::shared_ptr<AsyncGroupRun>& r);
+
+void stepFinished(const std::shared_ptr<AsyncGroupRun>& r, size_t i, Clock::time_point start, bool ok) {
+    {
+        std::lock_guard<std::mutex> lk(r->mx);
+        r->rep.steps[i].ok    = ok;
+        r->rep.steps[i].durMs = msSince(start, Clock::now());
+        --r->running;
+    }
+    pumpGroups(r);
+}
+
+// Startet, was gerade startbar ist. Meldet ein Schritt noch während des Startens (im
+// selben oder einem anderen Thread), sieht die Schleife das in der nächsten Runde.
+void pumpGroups(const std::shared_ptr<AsyncGroupRun>& r) {
+    std::unique_lock<std::mutex> lk(r->mx);
+    if (r->pumping) return;
+    r->pumping = true;
+    const auto& ops = r->plan->ops;
+    for (;;) {
+        if (r->preparing) break;
+
+        if (r->next < r->e && r->running < r->maxParallel) {
+            const size_t i = r->next++;
+            ++r->running;
+            // wie executeStepGroups: prepare-Zeit dem ersten Schritt zurechnen, bei
+            // gleichzeitigen Schritten allen
+            const auto start = (i == r->b || r->maxParallel > 1) ? r->gStart : Clock::now();
+            StepTiming& st = r->rep.steps[i];
+            st.index   = i;
+            st.group   = r->groups - 1;
+            st.startMs = msSince(r->t0, start);
+            lk.unlock();
+            try {
+                r->step(i, [r, i, start](bool ok){ stepFinished(r, i, start, ok); });
+            } catch (const std::exception& ex) {
+                std::cerr << "[PlanExecutor] step#" << i << " failed: " << ex.what() << "\n";
+                stepFinished(r, i, start, false);
+            }
+            lk.lock();
+            continue;
+        }
+        if (r->next < r->e || r->running > 0) break;   // Barriere: Gruppe läuft noch
+
+        // Gruppe fertig -> nächste Gruppe oder Planende
+        r->b = r->e;
+        if (r->b >= ops.size()) {
+            r->rep.totalMs = msSince(r->t0, Clock::now());
+            r->rep.ok = std::all_of(r->rep.steps.begin(), r->rep.steps.end(),
+                                    [](const StepTiming& s){ return s.ok; });
+            auto done = std::move(r->done);
+            PlanRunReport rep = std::move(r->rep);
+            lk.unlock();                 // pumping bleibt gesetzt: der Lauf ist beendet
+            if (done) done(std::move(rep));
+            return;
+        }
+        r->e      = stepGroupEnd(ops, r->b);
+        r->next   = r->b;
+        r->gStart = Clock::now();
+        ++r->groups;
+        if (!r->prepare) continue;
+
+        r->preparing = true;
+        const size_t b = r->b, e = r->e;
+        lk.unlock();
+        auto go = [r]{
+            { std::lock_guard<std::mutex> g(r->mx); r->preparing = false; }
+            pumpGroups(r);
+        };
+        try { r->prepare(b, e, go); }
+        catch (const std::exception& ex) {
+            std::cerr << "[PlanExecutor] prepare steps#" << b << ".." << (e - 1)
+                      << " failed: " << ex.what() << "\n";
+            go();
+        }
+        lk.lock();
+    }
+    r->pumping = false;
+}
+} // namespace
+
+std::string PlanRunReport::summary() const {
+    std::ostringstream os;
+    const size_t groups = steps.empty() ? 0 : steps.back().group + 1;
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%.1fms", totalMs);
+    os << steps.size() << " steps/" << groups << " groups " << buf;
+    for (const auto& s : steps) {
+        std::snprintf(buf, sizeof(buf), " +%.1f %.1fms ", s.startMs, s.durMs);
+        os << " | #" << s.index << " g" << s.group << buf << (s.ok ? "OK" : "FAIL");
+    }
+    return os.str();
+}
+
+PlanRunReport executeStepGroups(const std::vector<Operation>& ops,
+                                const std::function<bool(size_t)>& step,
+                                unsigned maxParallel,
+                                const std::function<void(size_t, size_t)>& prepare)
+{
+    PlanRunReport rep;
+    rep.steps.resize(ops.size());
+    const auto t0 = Clock::now();
+
+    auto runStep = [&](size_t i, size_t group, Clock::time_point start) {
+        StepTiming& st = rep.steps[i];
+        st.index   = i;
+        st.group   = group;
+        st.startMs = msSince(t0, start);
+        try { st.ok = step(i); }
+        catch (const std::exception& e) {
+            std::cerr << "[PlanExecutor] step#" << i << " failed: " << e.what() << "\n";
+            st.ok = false;
+        }
+        st.durMs = msSince(start, Clock::now());
+    };
+
+    size_t group = 0;
+    for (size_t b = 0; b < ops.size(); ++group) {
+        const size_t e = stepGroupEnd(ops, b);
+        const auto gStart = Clock::now();
+        if (prepare) prepare(b, e);
+
+        const size_t n = e - b;
+        const size_t workers = (std::min)(n, static_cast<size_t>((std::max)(maxParallel, 1u)));
+        if (workers <= 1) {
+            // prepare-Zeit dem ersten Schritt zurechnen, die übrigen ab ihrem Start
+            for (size_t i = b; i < e; ++i) runStep(i, group, i == b ? gStart : Clock::now());
+        } else {
+            std::atomic<size_t> next{b};
+            std::vector<std::future<void>> pool;
+            pool.reserve(workers);
+            for (size_t w = 0; w < workers; ++w) {
+                pool.push_back(std::async(std::launch::async, [&]{
+                    for (size_t i; (i = next.fetch_add(1)) < e; ) runStep(i, group, gStart);
+                }));
+            }
+            for (auto& f : pool) f.get();   // Barriere
+        }
+        b = e;
+    }
+
+    rep.totalMs = msSince(t0, Clock::now());
+    rep.ok = std::all_of(rep.steps.begin(), rep.steps.end(), [](const StepTiming& s){ return s.ok; });
+    return rep;
+}
+
+void executeStepGroupsAsync(std::shared_ptr<const Plan> plan,
+                            AsyncStepFn step,
+                            unsigned maxParallel,
+                            AsyncPrepareFn prepare,
+                            std::function<void(PlanRunReport)> done)
+{
+    auto r = std::make_shared<AsyncGroupRun>();
+    r->plan        = std::move(plan);
+    r->step        = std::move(step);
+    r->prepare     = std::move(prepare);
+    r->maxParallel = (std::max)(maxParallel, 1u);
+    r->done        = std::move(done);
+    r->rep.steps.resize(r->plan->ops.size());
+    r->t0 = Clock::now();
+    pumpGroups(r);
+}
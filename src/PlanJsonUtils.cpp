@@ -6,8 +6,12 @@
 // - Die erzeugten Pläne werden von MonitoringActionForce und SystemReactionForce verwendet,
 //   um die aus dem KG stammenden Monitoring- bzw. System-Reaktionen auszuführen.
 // - fixParamsRawIfNeeded(...) kann ggf. die JSON-Struktur reparieren (z. B. Header-Zeile).
+// - compiledCallMethodPlan(...) cached die Ergebnisse als Vorlagen je IRI (siehe unten).
 #include "PlanJsonUtils.h"
 #include <map>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
 using json = nlohmann::json;
 
@@ -75,7 +79,7 @@ void assignTyped(UAValueMap& target, int idx, const std::string& t, const json&
 }
 
 // --- Kern: Payload -> Plan (CallMethod), optional mit Abschluss-Puls ----------
-Plan buildCallMethodPlanFromPayload(const std::string& corr,
+Plan buildCallMethodPlanFromPayload(CorrelationId corr,
                                     const std::string& payload,
                                     bool appendPulse,
                                     const std::string& resourceId)
@@ -152,6 +156,17 @@ Plan buildCallMethodPlanFromPayload(const std::string& corr,
                 if (r["v"].is_number_integer())        getOp(step).timeoutMs = r["v"].get<int>();
                 else if (r["v"].is_string()) { try {   getOp(step).timeoutMs = std::stoi(r["v"].get<std::string>()); } catch (...) {} }
             }
+        } else if (g=="meta"   && k=="independent") {
+            if (r.contains("v")) {
+                const auto& v = r["v"];
+                getOp(step).independent = v.is_boolean() ? v.get<bool>()
+                                        : (v.is_string() && (v.get<std::string>()=="true" || v.get<std::string>()=="1"));
+            }
+        } else if (g=="meta"   && k=="group") {
+            if (r.contains("v")) {
+                if (r["v"].is_number_integer())        getOp(step).group = r["v"].get<int>();
+                else if (r["v"].is_string()) { try {   getOp(step).group = std::stoi(r["v"].get<std::string>()); } catch (...) {} }
+            }
         } else if (g=="input") {
             if (r.contains("v")) assignTyped(getOp(step).inputs,  idx, t, r["v"]);
         } else if (g=="output") {
@@ -171,4 +186,60 @@ Plan buildCallMethodPlanFromPayload(const std::string& corr,
         plan.ops.push_back(Operation{ OpType::PulseBool, "OPCUA.DiagnoseFinished", 4, "true", "", 100 });
     }
     return plan;
-}
\ No newline at end of file
+}
+// --- Cache kompilierter Pläne ------------------------------------------------
+// Ein Slot je (IRI, resourceId, appendPulse); Hash + Payload entscheiden über den Treffer.
+namespace {
+struct CompiledSlot {
+    size_t                      hash = 0;
+    std::string                 payload;   // Gegenprüfung bei Hash-Treffer
+    std::shared_ptr<const Plan> plan;
+};
+
+std::mutex                                    g_planMx;
+std::unordered_map<std::string, CompiledSlot> g_plans;
+
+// IRI-Header wie in MonActionForce/SystemReactionForce (erste Zeile bzw. alles vor '{')
+std::string_view payloadIri(std::string_view payload) {
+    const auto nl    = payload.find('\n');
+    const auto brace = payload.find('{', (nl == std::string_view::npos) ? 0 : nl);
+    std::string_view iri = (nl == std::string_view::npos) ? payload.substr(0, brace) : payload.substr(0, nl);
+    while (!iri.empty() && (iri.back()=='\r' || iri.back()=='\n' || iri.back()==' ' || iri.back()=='\t'))
+        iri.remove_suffix(1);
+    return iri;
+}
+} // namespace
+
+std::shared_ptr<const Plan> compiledCallMethodPlan(const std::string& payload,
+                                                   bool appendPulse,
+                                                   const std::string& resourceId)
+{
+    std::string key(payloadIri(payload));
+    key += '\n';
+    key += resourceId;
+    key += appendPulse ? "\n1" : "\n0";
+    const size_t hash = std::hash<std::string_view>{}(payload);
+
+    {
+        std::lock_guard<std::mutex> lk(g_planMx);
+        auto it = g_plans.find(key);
+        if (it != g_plans.end() && it->second.hash == hash && it->second.payload == payload)
+            return it->second.plan;
+    }
+
+    // Kompilieren ohne Lock (parallele Kandidaten blockieren sich nicht gegenseitig)
+    auto plan = std::make_shared<const Plan>(
+        buildCallMethodPlanFromPayload(CorrelationId{}, payload, appendPulse, resourceId));
+
+    std::lock_guard<std::mutex> lk(g_planMx);
+    CompiledSlot& slot = g_plans[std::move(key)];
+    slot.hash    = hash;
+    slot.payload = payload;
+    slot.plan    = plan;
+    return plan;
+}
+
+void invalidateCompiledPlans() {
+    std::lock_guard<std::mutex> lk(g_planMx);
+    g_plans.clear();
+}
@@ -17,11 +17,14 @@
 #include "CommandForceFactory.h"
 #include "EventBus.h"
 #include "PythonWorker.h"
+#include "KGIndex.h"
+#include "KgResponseParser.h"
 #include <thread>
 #include <chrono>
 #include <unordered_map>
 #include <sstream>
 #include <optional>
+#include <string_view>
 #include "Event.h"
 #include "PLCMonitor.h"
 #include "Plan.h"
@@ -34,6 +37,10 @@ using json  = nlohmann::json;
 using Clock = std::chrono::steady_clock;
 namespace py = pybind11;
 
+// KG-Lookups über Python laufen mit hoher Priorität im Worker-Pool; startet der Job
+// nicht innerhalb dieser Frist, wird er verworfen (Aufrufer nimmt dann leere rows).
+static constexpr PythonWorker::Deadline kKgDeadline{5000};
+
 // ---------- Logging -----------------------------------------------------------
 namespace {
 struct NullBuf : public std::streambuf { int overflow(int c) override { return c; } };
@@ -56,10 +63,6 @@ std::ostream& ReactionManager::log(LogLevel lvl) const {
     return nullout_stream;
 }
 
-std::string ReactionManager::makeCorrelationId(const char* evName) {
-    return std::string(evName) + "-" + std::to_string(Clock::now().time_since_epoch().count());
-}
-
 // ---------- Konstruktor: Worker-Thread ---------------------------------------
 ReactionManager::ReactionManager(PLCMonitor& mon, EventBus& bus)
     : mon_(mon), bus_(bus)
@@ -80,6 +83,14 @@ ReactionManager::ReactionManager(PLCMonitor& mon, EventBus& bus)
     });
 }
 
+void ReactionManager::enqueueJob(std::function<void(std::stop_token)> job) {
+    {
+        std::lock_guard<std::mutex> lk(job_mx_);
+        jobs_.push(std::move(job));
+    }
+    job_cv_.notify_one();
+}
+
 ReactionManager::~ReactionManager() {
     if (worker_.joinable()) {
         worker_.request_stop();      // Stop-Flag setzen
@@ -92,21 +103,22 @@ ReactionManager::~ReactionManager() {
 // ---------- Event-Entry -------------------------------------------------------
 void ReactionManager::onEvent(const Event& ev) {
     const char* evName = nullptr;
+    CorrSource  src    = CorrSource::None;
     switch (ev.type) {
-        case EventType::evD1: evName = "evD1"; break;
-        case EventType::evD2: evName = "evD2"; break;
-        case EventType::evD3: evName = "evD3"; break;
+        case EventType::evD1: evName = "evD1"; src = CorrSource::D1; break;
+        case EventType::evD2: evName = "evD2"; src = CorrSource::D2; break;
+        case EventType::evD3: evName = "evD3"; src = CorrSource::D3; break;
         default: return;
     }
 
     // Nur evD2 hat hier „Arbeit“ – und zwar *ausschließlich* mit dem Snapshot aus der Payload.
-    std::string       corr = makeCorrelationId(evName);
-    InventorySnapshot inv;
+    // CorrelationId kommt vom Erzeuger (Event übernimmt sie aus der Payload); nur ohne Id eine neue.
+    CorrelationId        corr = ev.correlationId.valid() ? ev.correlationId : makeCorrelationId(src);
+    InventorySnapshotPtr snap;   // geteilt mit allen anderen Konsumenten, keine Kopie
 
     if (ev.type == EventType::evD2) {
-        if (auto p = std::any_cast<D2Snapshot>(&ev.payload)) {
-            if (!p->correlationId.empty()) corr = p->correlationId;
-            inv = p->inv;
+        if (auto p = std::get_if<D2Snapshot>(&ev.payload); p && p->inv) {
+            snap = p->inv;
         } else {
             log(LogLevel::Warn) << "evD2 ohne D2Snapshot-Payload -> ignoriere\n";
             return;
@@ -117,13 +129,15 @@ void ReactionManager::onEvent(const Event& ev) {
     }
 
     log(LogLevel::Info) << "onEvent ENTER " << evName << " corr=" << corr << "\n";
+    const InventorySnapshot& inv = *snap;
     logInventoryVariables(inv);
     const std::string processName = getStringFromCache(inv, /*ns*/4, "OPCUA.lastExecutedProcess");
 
     // --- Worker-Job -----------------------------------------------------------
     {
         std::lock_guard<std::mutex> lk(job_mx_);
-        jobs_.push([this, corr, inv, processName](std::stop_token st) mutable {
+        jobs_.push([this, corr, snap, processName](std::stop_token st) mutable {
+            const InventorySnapshot& inv = *snap;
             log(LogLevel::Info) << "[worker] corr=" << corr << " START\n";
             const auto lap = [this, t0=Clock::now()](const char* tag) {
                 auto dt = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now()-t0).count();
@@ -132,37 +146,45 @@ void ReactionManager::onEvent(const Event& ev) {
 
             // 1) KG-Parameter anhand unterbrochenem Skill (nur Cache!)
             const std::string interruptedSkill = getLastExecutedSkill(inv);
-            std::string srows;
-            try {
-                srows = PythonWorker::instance().call([&](){
-                    py::module_ sys = py::module_::import("sys");
-                    py::list path = sys.attr("path").cast<py::list>();
-                    path.append(R"(C:\Users\Alexander Verkhov\OneDrive\Dokumente\MPA\Implementierung_MPA\Test\src)");
-                    py::module_ kg  = py::module_::import("KG_Interface");
-                    py::object kgi  = kg.attr("KGInterface")();
-                    if (interruptedSkill.empty()) {
-                        // Fallback: ggf. neutraler Skillname
-                        return std::string(R"({"rows":[]})");
-                    }
-                    py::object res  = kgi.attr("getFailureModeParameters")(interruptedSkill.c_str());
-                    return std::string(py::str(res));
-                });
+            // Nativer Index (O(1), ohne GIL) liefert Text; Python/rdflib nur, wenn nicht
+            // geladen – dann als (IRI, Params)-Tupel, bereits typisiert
+            std::string    srows;
+            KgCandidateSet pyCands;
+            const bool native = !interruptedSkill.empty() &&
+                KGIndex::instance().failureModeParameters(interruptedSkill, srows);
+            if (native) {
                 log(LogLevel::Info) << "[worker] KG.getFailureModeParameters OK json_len=" << srows.size()
                                     << " preview=\"" << srows/*.substr(0, std::min<size_t>(srows.size(), 120))*/ << "\"\n";
-            } catch (const std::exception& e) {
-                log(LogLevel::Warn) << "[worker] KG error: " << e.what() << "\n";
-                srows = R"({"rows":[]})";
+            } else if (!interruptedSkill.empty()) {
+                try {
+                    pyCands = fetchFailureModeCandidates(interruptedSkill);
+                    log(LogLevel::Info) << "[worker] KG.getFailureModeParameterPairs OK candidates="
+                                        << pyCands.cands.size() << "\n";
+                } catch (const std::exception& e) {
+                    log(LogLevel::Warn) << "[worker] KG error: " << e.what() << "\n";
+                    pyCands = {};
+                }
             }
             lap("kg-params-ready");
             if (st.stop_requested()) { log(LogLevel::Warn) << "[worker] stop requested -> abort corr=" << corr << "\n"; return; }
 
-            // 2) Kandidaten parsen & Checks gegen *Cache*
-            auto potCands = normalizeKgPotFM(srows);
+            // 2) Kandidaten (je Skill/KG-Antwort/Inventarstand einmal kompiliert) gegen *Cache*
+            const size_t srcHash = native ? std::hash<std::string_view>{}(srows) : pyCands.srcHash;
+            const auto compiled = compileCandidates(interruptedSkill, srcHash, [&]{
+                return native ? normalizeKgPotFM(srows) : std::move(pyCands.cands);
+            }, inv);
+            const auto& potCands = compiled->cands;
             std::vector<std::string> winners;
             winners.reserve(potCands.size());
-            for (const auto& c : potCands) {
-                auto rep = compareAgainstCache(inv, c.expects);
-                if (rep.allOk) winners.push_back(c.potFM);
+            const bool debugReports = isEnabled(LogLevel::Debug);
+            for (size_t c = 0; c < potCands.size(); ++c) {
+                if (compiled->checks.passes(inv, c)) { winners.push_back(potCands[c].potFM); continue; }
+                if (!debugReports) continue;
+                // Detail-Report nur bei Debug (Strings je Erwartung)
+                const auto rep = compareAgainstCache(inv, potCands[c].expects);
+                for (const auto& it : rep.items)
+                    if (!it.ok) log(LogLevel::Debug) << "[potFM] " << potCands[c].potFM << " fail: "
+                                                     << nodeKeyToStr(it.key) << " " << it.detail << "\n";
             }
             lap("potFM-selected");
 
@@ -182,18 +204,25 @@ void ReactionManager::onEvent(const Event& ev) {
                 const std::string& winner = winners.front();
                 bus_.post(Event{
                         EventType::evGotFM, Clock::now(),
-                        std::any{ GotFMAck {
+                        GotFMAck {
                             corr,
                             winner
-                        } }
+                        }
                     });
                 auto wfSys = CommandForceFactory::createSystemReactionFilter(
                     mon_, bus_,
                     [this](const std::string& fmIri){ return fetchSystemReactionForFM(fmIri); },
                     /*defaultTimeoutMs=*/30000
                 );
-                winners = wfSys->filter(winners, corr, processName); // <— ebenfalls filter(...)
-                log(LogLevel::Info) << "[worker] corr=" << corr << " END (winner ok)\n";
+                // Ohne blockierende Wartezeiten: Calls/Waits laufen im UA-Thread weiter, der
+                // Worker ist sofort frei für die nächste Korrelation. wfSys darf danach sterben.
+                wfSys->filterAsync(winners, corr, processName,
+                    [weak = weak_from_this(), corr](std::vector<std::string> kept) {
+                        if (auto self = weak.lock())
+                            self->log(LogLevel::Info) << "[worker] corr=" << corr << " END (winner "
+                                                      << (kept.empty() ? "failed" : "ok") << ")\n";
+                    });
+                log(LogLevel::Info) << "[worker] corr=" << corr << " system reaction running\n";
                 return;
             // 5) Fallback bei 0 oder >1 Gewinnern -> DiagnoseFinished-Puls
             } else {
@@ -201,11 +230,11 @@ void ReactionManager::onEvent(const Event& ev) {
                     // -> KG lieferte 0 Kandidaten: UnknownFM posten und danach Puls auslösen
                     bus_.post(Event{
                         EventType::evUnknownFM, Clock::now(),
-                        std::any{ UnknownFMAck{
+                        UnknownFMAck{
                             corr,
                             processName,  // oder "UnknownFM"
                             std::string("KG: no failure modes for skill '") + interruptedSkill + "'"
-                        } }
+                        }
                     });
                     log(LogLevel::Info) << "[potFM] KG lieferte 0 Kandidaten -> UnknownFM + Fallback (Pulse DiagnoseFinished)\n";
                 } else if (winners.empty()) {
@@ -232,22 +261,22 @@ void ReactionManager::onEvent(const Event& ev) {
 
 // ---------- Inventar / Cache-Helper ------------------------------------------
 void ReactionManager::logInventoryVariables(const InventorySnapshot& inv) const {
-    log(LogLevel::Info) << "buildInventorySnapshot BOOL vars=" << inv.bools.size()
-                        << " | STR vars=" << inv.strings.size()
-                        << " | I16 vars=" << inv.int16s.size()
-                        << " | FP vars="  << inv.floats.size() << "\n";
+    log(LogLevel::Info) << "buildInventorySnapshot BOOL vars=" << inv.count(VarKind::Bool)
+                        << " | STR vars=" << inv.count(VarKind::String)
+                        << " | I16 vars=" << inv.count(VarKind::Int16)
+                        << " | FP vars="  << inv.count(VarKind::Float) << "\n";
 
     if (!isEnabled(LogLevel::Debug)) return;
 
     std::cout << "[Inventory] Variablen + Typen (mit Cache-Werten, falls vorhanden):\n";
-    for (const auto& r : inv.rows) {
+    for (const auto& r : inv.rowList()) {
         std::cout << "  - " << r.nodeId << "  (" << r.dtypeOrSig << ")\n";
     }
 }
 
 std::string ReactionManager::getStringFromCache(const InventorySnapshot& inv, uint16_t ns, const std::string& id) {
-    auto it = inv.strings.find(NodeKey{ns,'s',id});
-    return it == inv.strings.end() ? std::string{} : it->second;
+    const std::string* v = inv.findString(NodeKey{ns,'s',id});
+    return v ? *v : std::string{};
 }
 
 std::string ReactionManager::getLastExecutedSkill(const InventorySnapshot& inv) {
@@ -256,89 +285,80 @@ std::string ReactionManager::getLastExecutedSkill(const InventorySnapshot& inv)
 }
 
 // ---------- KG-Brücke (Python) -----------------------------------------------
-std::string ReactionManager::fetchFailureModeParameters(const std::string& skillName) {
-    // (nicht direkt genutzt – wir rufen oben PythonWorker inline)
-    return {};
+// Zuerst der native KGIndex; ist er nicht geladen, die langlebige KG-Session des
+// PythonWorker (PythonWorker::kg()).
+// Python-Strings als View auf ihren UTF-8-Puffer (gültig, solange das Objekt lebt und der
+// GIL gehalten wird; bei ASCII ohne Kopie)
+static bool pyStrView(PyObject* o, std::string_view& out) {
+    if (!PyUnicode_Check(o)) return false;
+    Py_ssize_t n = 0;
+    const char* p = PyUnicode_AsUTF8AndSize(o, &n);
+    if (!p) { PyErr_Clear(); return false; }
+    out = std::string_view(p, static_cast<size_t>(n));
+    return true;
+}
+
+static size_t hashCombine(size_t h, std::string_view v) {
+    h ^= std::hash<std::string_view>{}(v) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+ReactionManager::KgCandidateSet
+ReactionManager::fetchFailureModeCandidates(const std::string& skillName) {
+    return PythonWorker::instance().call([&]() -> KgCandidateSet {
+        KgCandidateSet set;
+        // langlebige KG-Session (Graph einmal geparst, Query vorbereitet)
+        py::object res = PythonWorker::instance().kg()
+                             .attr("getFailureModeParameterPairs")(skillName.c_str());
+        // Tupel direkt lesen: IRI und Params-JSON als Views, Params ohne DOM in KgExpect
+        for (py::handle item : res) {
+            PyObject* t = item.ptr();
+            if (!PyTuple_Check(t) || PyTuple_GET_SIZE(t) != 2) continue;
+            std::string_view iri, params;
+            if (!pyStrView(PyTuple_GET_ITEM(t, 0), iri) || !pyStrView(PyTuple_GET_ITEM(t, 1), params)) continue;
+            set.srcHash = hashCombine(hashCombine(set.srcHash, iri), params);
+
+            KgCandidate c{ std::string(iri), {} };
+            if (!parseKgExpects(params, c.expects)) {
+                c.malformed = true;
+                log(LogLevel::Warn) << "[potFM] malformed params for '" << c.potFM << "'\n";
+            }
+            set.cands.push_back(std::move(c));
+        }
+        return set;
+    }, PythonWorker::Priority::High, kKgDeadline);
 }
 std::string ReactionManager::fetchMonitoringActionForFM(const std::string& fmIri) {
+    std::string out;
+    if (KGIndex::instance().monitoringActionsForFM(fmIri, out)) return out;
     try {
         return PythonWorker::instance().call([&]() -> std::string {
-            py::module_ sys = py::module_::import("sys");
-            py::list path   = sys.attr("path").cast<py::list>();
-            path.append(R"(C:\Users\Alexander Verkhov\OneDrive\Dokumente\MPA\Implementierung_MPA\Test\src)");
-            py::module_ kg  = py::module_::import("KG_Interface");
-            py::object kgi  = kg.attr("KGInterface")();
-            py::object res  = kgi.attr("getMonitoringActionForFailureMode")(fmIri.c_str());
+            py::object res  = PythonWorker::instance().kg()
+                                  .attr("getMonitoringActionForFailureMode")(fmIri.c_str());
             return std::string(py::str(res));
-        });
+        }, PythonWorker::Priority::High, kKgDeadline);
     } catch (...) { return R"({"rows":[]})"; }
 }
 std::string ReactionManager::fetchSystemReactionForFM(const std::string& fmIri) {
+    std::string out;
+    if (KGIndex::instance().systemReactionsForFM(fmIri, out)) return out;
     try {
         return PythonWorker::instance().call([&]() -> std::string {
-            py::module_ sys = py::module_::import("sys");
-            py::list path   = sys.attr("path").cast<py::list>();
-            path.append(R"(C:\Users\Alexander Verkhov\OneDrive\Dokumente\MPA\Implementierung_MPA\Test\src)");
-            py::module_ kg  = py::module_::import("KG_Interface");
-            py::object kgi  = kg.attr("KGInterface")();
-            py::object res  = kgi.attr("getSystemreactionForFailureMode")(fmIri.c_str());
+            py::object res  = PythonWorker::instance().kg()
+                                  .attr("getSystemreactionForFailureMode")(fmIri.c_str());
             //std::cout << std::string(py::str(res)) << "/n";
             return std::string(py::str(res));
-        });
+        }, PythonWorker::Priority::High, kKgDeadline);
     } catch (...) { return R"({"rows":[]})"; }
 }
 
 // ---------- Normalisieren & Vergleichen --------------------------------------
-static bool json_get_first_object(const json& j, json& out) {
-    if (j.is_object()) { out = j; return true; }
-    if (j.is_array()) {
-        if (j.empty()) return false;
-        if (j[0].is_object()) { out = j[0]; return true; }
-        if (j.size()>=2 && j[1].is_object()) { out = j[1]; return true; } // [header, rows]
-    }
-    return false;
-}
-
 std::vector<ReactionManager::KgExpect>
 ReactionManager::normalizeKgResponse(const std::string& rowsJson) {
     std::vector<KgExpect> out;
     if (rowsJson.empty()) return out;
-
-    json j;
-    try { j = json::parse(rowsJson); } catch (...) { return out; }
-
-    json rows;
-    if (!json_get_first_object(j, rows)) return out;
-
-    auto arrIt = rows.find("rows");
-    if (arrIt == rows.end() || !arrIt->is_array()) return out;
-
-    for (const auto& r : *arrIt) {
-        if (!r.contains("id") || !r.contains("t") || !r.contains("v")) continue;
-        const std::string idText = r["id"].get<std::string>();
-        const std::string tIn    = r["t"].get<std::string>();
-        std::string t = tIn;
-        std::transform(t.begin(), t.end(), t.begin(),
-                    [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
-
-        // >>> UA-NodeId "ns=4;s=OPCUA.x" → NodeKey{ns=4,'s',"OPCUA.x"}
-        uint16_t ns = 4; std::string idStr; char idType='s';
-        if (!parseNsAndId(idText, ns, idStr, idType)) { idStr = idText; idType='s'; } // erlaubt auch Kurzform "OPCUA.x"
-        KgExpect e; e.key = NodeKey{ ns, idType, idStr };
-        if      (t=="b" || t=="bool" || t=="boolean") {
-            e.kind = KgValKind::Bool;    e.expectedBool = r["v"].get<bool>();
-        }
-        else if (t=="i" || t=="int" || t=="int16" || t=="i16") {
-            e.kind = KgValKind::Int16;   e.expectedI16  = r["v"].get<int16_t>();
-        }
-        else if (t=="f" || t=="float" || t=="double") {
-            e.kind = KgValKind::Float64; e.expectedF64  = r["v"].get<double>();
-        }
-        else {
-            e.kind = KgValKind::String;  e.expectedStr  = r["v"].get<std::string>();
-        }
-        out.push_back(std::move(e));
-    }
+    // Ein Durchlauf ohne JSON-DOM (KgResponseParser); Syntaxfehler -> keine Erwartungen
+    parseKgExpects(rowsJson, out);
     return out;
 }
 
@@ -346,93 +366,70 @@ std::vector<ReactionManager::KgCandidate>
 ReactionManager::normalizeKgPotFM(const std::string& srows) {
     log(LogLevel::Info) << "normalizeKgPotFM ENTER len=" << srows.size() << "\n";
 
-    std::vector<KgCandidate> out;
-
-    // 1) Optional: äußere Quotes entfernen (manche Python-Returns kommen als quoted-String)
-    std::string s = srows;
-    if (s.size() >= 2 && s.front()=='"' && s.back()=='"') {
-        s = s.substr(1, s.size()-2);
+    // Mehrere IRI+JSON-Paare in einem Durchlauf über die Antwort (ohne Teilstring-Kopien)
+    KgParseStats st;
+    std::vector<KgCandidate> out = parseKgCandidates(srows, &st);
+
+    if (st.missingJson)
+        log(LogLevel::Warn) << "[potFM] " << st.missingJson << "x expected JSON after IRI\n";
+    if (st.malformed)
+        log(LogLevel::Warn) << "[potFM] " << st.malformed << "x malformed JSON block\n";
+    for (size_t idx = 0; idx < out.size(); ++idx) {
+        log(LogLevel::Debug) << "[potFM#" << (idx+1) << "] iri='" << out[idx].potFM
+                             << "' expects=" << out[idx].expects.size() << "\n";
+        if (out[idx].expects.empty())
+            log(LogLevel::Warn) << "[potFM#" << (idx+1) << "] no expects parsed\n";
     }
 
-    // kleine Helfer
-    auto skipWS = [&](size_t& p) {
-        while (p < s.size()) {
-            char c = s[p];
-            if (c==' ' || c=='\t' || c=='\r' || c=='\n') { ++p; continue; }
-            break;
-        }
-    };
-    auto trimInPlace = [](std::string& x) {
-        size_t a = x.find_first_not_of(" \t");
-        size_t b = x.find_last_not_of(" \t");
-        x = (a==std::string::npos) ? std::string{} : x.substr(a, b-a+1);
-    };
-
-    // 2) Mehrere IRI+JSON-Paare hintereinander parsen
-    size_t pos = 0;
-    size_t idx = 0;
-    while (true) {
-        skipWS(pos);
-        if (pos >= s.size()) break;
-
-        // IRI bis zum Zeilenende lesen
-        size_t eol = s.find_first_of("\r\n", pos);
-        std::string iri = (eol==std::string::npos) ? s.substr(pos) : s.substr(pos, eol-pos);
-        trimInPlace(iri);
-        if (iri.empty()) {
-            if (eol==std::string::npos) break;
-            pos = eol + 1;
-            continue;
-        }
-
-        // zur nächsten Nicht-CR/LF-Position
-        pos = (eol==std::string::npos) ? s.size() : eol;
-        while (pos < s.size() && (s[pos]=='\r' || s[pos]=='\n')) ++pos;
-        skipWS(pos);
+    log(LogLevel::Info) << "normalizeKgPotFM EXIT candidates=" << out.size() << "\n";
+    return out;
+}
 
-        // Nächster Block muss ein JSON-Objekt sein, das bei '{' startet
-        if (pos >= s.size() || s[pos] != '{') {
-            log(LogLevel::Warn) << "[potFM#" << (idx+1) << "] expected JSON after IRI, got pos=" << pos << "\n";
-            continue;
-        }
 
-        // Ausgewogenes JSON ab pos erfassen (Klammerzähler, string-aware)
-        size_t start = pos;
-        int    depth = 0;
-        bool   inStr = false, esc = false;
-
-        for (; pos < s.size(); ++pos) {
-            char c = s[pos];
-            if (inStr) {
-                if (esc) { esc=false; continue; }
-                if (c=='\\') { esc=true; continue; }
-                if (c=='"') { inStr=false; }
-                continue;
+// ---------- Vorkompilierte Checks ---------------------------------------------
+static CompiledChecks compileChecks(const NodeTablePtr& nodes,
+                                    const std::vector<ReactionManager::KgCandidate>& cands)
+{
+    using K = ReactionManager::KgValKind;
+    CompiledChecks cc(nodes);
+    for (const auto& c : cands) {
+        cc.beginCandidate();
+        if (c.malformed) cc.markDead();
+        for (const auto& e : c.expects) {
+            switch (e.kind) {
+                case K::Bool:    cc.expectBool  (e.key, e.expectedBool); break;
+                case K::Int16:   cc.expectInt16 (e.key, e.expectedI16);  break;
+                case K::Float64: cc.expectFloat (e.key, e.expectedF64);  break;
+                case K::String:  cc.expectString(e.key, e.expectedStr);  break;
             }
-            if (c=='"') { inStr=true; continue; }
-            if (c=='{') { ++depth; continue; }
-            if (c=='}') { --depth; if (depth==0) { ++pos; break; } }
-        }
-        const std::string jsonPart = s.substr(start, pos-start);
-
-        ++idx;
-        log(LogLevel::Debug) << "[potFM#" << idx << "] iri='" << iri << "' json.len=" << jsonPart.size() << "\n";
-
-        // 3) JSON-Block wie gehabt in Erwartungen verwandeln
-        auto expects = normalizeKgResponse(jsonPart);
-        if (expects.empty()) {
-            log(LogLevel::Warn) << "[potFM#" << idx << "] no expects parsed\n";
         }
+    }
+    return cc;
+}
 
-        out.push_back(KgCandidate{ iri, std::move(expects) });
-
-        // danach geht die while-Schleife weiter -> evtl. nächstes IRI+JSON-Paar
+ReactionManager::CompiledCandidatesPtr
+ReactionManager::compileCandidates(const std::string& skill, size_t srcHash,
+                                   const std::function<std::vector<KgCandidate>()>& parse,
+                                   const InventorySnapshot& inv)
+{
+    {
+        std::lock_guard<std::mutex> lk(compiled_mx_);
+        auto it = compiled_.find(skill);
+        // Treffer nur bei identischer KG-Antwort (KG-Änderungen) und gleichem Inventarstand
+        if (it != compiled_.end() && it->second->srcHash == srcHash && it->second->checks.matches(inv))
+            return it->second;
     }
 
-    log(LogLevel::Info) << "normalizeKgPotFM EXIT candidates=" << out.size() << "\n";
-    return out;
-}
+    auto cc = std::make_shared<CompiledCandidates>();
+    cc->srcHash = srcHash;
+    cc->cands   = parse();
+    cc->checks = compileChecks(inv.nodes, cc->cands);
+    log(LogLevel::Info) << "[potFM] compiled " << cc->cands.size() << " candidates for skill '"
+                        << skill << "'\n";
 
+    std::lock_guard<std::mutex> lk(compiled_mx_);
+    return compiled_[skill] = std::move(cc);
+}
 
 ReactionManager::ComparisonReport
 ReactionManager::compareAgainstCache(const InventorySnapshot& inv,
@@ -440,37 +437,36 @@ ReactionManager::compareAgainstCache(const InventorySnapshot& inv,
 {
     ComparisonReport rep; rep.allOk = true;
 
+    // Slot je Erwartung: aufgelöst über die NodeTable des Snapshots (ein Lookup je Key),
+    // danach reine Spaltenzugriffe.
     auto checkOne = [&](const KgExpect& e)->ComparisonItem {
         ComparisonItem it; it.key = e.key; it.ok = false;
+        const uint32_t slot = inv.slotOf(e.key);
 
         switch (e.kind) {
             case KgValKind::Bool: {
-                auto f = inv.bools.find(e.key);
-                if (f != inv.bools.end()) { it.ok = (f->second == e.expectedBool); if(!it.ok) it.detail="bool diff"; }
+                if (inv.has(slot, VarKind::Bool)) { it.ok = ((inv.colBool[slot] != 0) == e.expectedBool); if(!it.ok) it.detail="bool diff"; }
                 else {
                     it.detail = "bool not in cache";
                     log(LogLevel::Debug) << "[cache-miss] " << nodeKeyToStr(e.key) << "\n";
                 }
             } break;
             case KgValKind::Int16: {
-                auto f = inv.int16s.find(e.key);
-                if (f != inv.int16s.end()) { it.ok = (f->second == e.expectedI16); if(!it.ok) it.detail="i16 diff"; }
+                if (inv.has(slot, VarKind::Int16)) { it.ok = (inv.colI16[slot] == e.expectedI16); if(!it.ok) it.detail="i16 diff"; }
                 else {
                     it.detail = "Int16 not in cache";
                     log(LogLevel::Debug) << "[cache-miss] " << nodeKeyToStr(e.key) << "\n";
                 }
             } break;
             case KgValKind::Float64: {
-                auto f = inv.floats.find(e.key);
-                if (f != inv.floats.end()) { it.ok = (f->second == e.expectedF64); if(!it.ok) it.detail="f64 diff"; }
+                if (inv.has(slot, VarKind::Float)) { it.ok = (inv.colF64[slot] == e.expectedF64); if(!it.ok) it.detail="f64 diff"; }
                 else {
                     it.detail = "Float64 not in cache";
                     log(LogLevel::Debug) << "[cache-miss] " << nodeKeyToStr(e.key) << "\n";
                 }
             } break;
             case KgValKind::String: {
-                auto f = inv.strings.find(e.key);
-                if (f != inv.strings.end()) { it.ok = (f->second == e.expectedStr); if(!it.ok) it.detail="str diff"; }
+                if (inv.has(slot, VarKind::String)) { it.ok = (inv.colStr[slot] == e.expectedStr); if(!it.ok) it.detail="str diff"; }
                 else {
                     it.detail = "str not in cache";
                     log(LogLevel::Debug) << "[cache-miss] " << nodeKeyToStr(e.key) << "\n";
@@ -493,15 +489,14 @@ ReactionManager::selectPotFMByChecks(const InventorySnapshot& inv,
                                      const std::vector<KgCandidate>& cands)
 {
     std::vector<KgCandidate> winners;
-    for (const auto& c : cands) {
-        auto rep = this->compareAgainstCache(inv, c.expects);
-        if (rep.allOk) winners.push_back(c);
-    }
+    const CompiledChecks cc = compileChecks(inv.nodes, cands);
+    for (size_t c = 0; c < cands.size(); ++c)
+        if (cc.passes(inv, c)) winners.push_back(cands[c]);
     return winners;
 }
 
 // ---------- Plan-Erstellung & -Ausführung ------------------------------------
-Plan ReactionManager::buildPlanFromComparison(const std::string& corr,
+Plan ReactionManager::buildPlanFromComparison(CorrelationId corr,
                                               const ComparisonReport&) const
 {
     // Minimal-Fallback: DiagnoseFinished pulsen
@@ -527,44 +522,62 @@ void ReactionManager::createCommandForceForPlanAndAck(const Plan& plan,
     // Ack: PLANNED
     bus_.post(Event{
         EventType::evSRPlanned, Clock::now(),
-        std::any{ ReactionPlannedAck{
+        ReactionPlannedAck{
             plan.correlationId,
             plan.resourceId,
             checksOk
               ? std::string("SystemReaction/MonitoringAction (KG)")
               : std::string("KG checks fail or ambiguous -> pulse DiagnoseFinished")
-        } }
+        }
     });
 
-    bool allOk = true;
-    for (const auto& op : plan.ops) {
-        auto cf = CommandForceFactory::createForOp(op, &mon_, bus_);
-        if (!cf) { allOk = false; continue; }
-        int rc = cf->execute(plan);
-        allOk = allOk && (rc != 0);
+    // Ausführung ohne blockierende Wartezeiten: der Worker ist sofort wieder frei
+    executePlanFrom(std::make_shared<const Plan>(plan), 0, /*allOk=*/true, processNameForFail);
+
+    log(LogLevel::Info) << "createCommandForceForPlanAndAck EXIT (plan running)\n";
+}
+
+void ReactionManager::executePlanFrom(std::shared_ptr<const Plan> plan, size_t k, bool allOk,
+                                      std::string processNameForFail)
+{
+    if (k < plan->ops.size()) {
+        std::shared_ptr<ICommandForce> cf = CommandForceFactory::createForOp(plan->ops[k], &mon_, bus_);
+        if (!cf) { executePlanFrom(std::move(plan), k + 1, false, std::move(processNameForFail)); return; }
+        // done(...) kann aus dem UA-Thread (Monitor-Timer, disconnect) kommen -> zurück in den
+        // Worker; ist der Manager schon weg, verfällt die Fortsetzung (weak_ptr statt this).
+        // Der Job selbst darf this nutzen: der Destruktor arbeitet die Queue vor dem Join ab.
+        cf->executeAsync(*plan, [weak = weak_from_this(), plan, k, allOk,
+                                 proc = std::move(processNameForFail), cf](int rc) {
+            auto self = weak.lock();
+            if (!self) return;
+            ReactionManager* rm = self.get();
+            rm->enqueueJob([rm, plan, k, ok = allOk && (rc != 0), proc](std::stop_token) {
+                rm->executePlanFrom(plan, k + 1, ok, proc);
+            });
+        });
+        return;
     }
 
-    const bool hasCall = std::any_of(plan.ops.begin(), plan.ops.end(),
+    const bool hasCall = std::any_of(plan->ops.begin(), plan->ops.end(),
                                      [](const Operation& o){ return o.type==OpType::CallMethod; });
     if (!hasCall) {
         bus_.post(Event{
             EventType::evProcessFail, Clock::now(),
-            std::any{ ProcessFailAck{
-                plan.correlationId,
+            ProcessFailAck{
+                plan->correlationId,
                 processNameForFail,
                 "No unique system reaction; fallback used."
-            } }
+            }
         });
     }
 
     bus_.post(Event{
         EventType::evSRDone, Clock::now(),
-        std::any{ ReactionDoneAck{
-            plan.correlationId,
+        ReactionDoneAck{
+            plan->correlationId,
             allOk ? 1 : 0,
             allOk ? "OK" : "FAIL"
-        } }
+        }
     });
-
-    log(LogLevel::Info) << "createCommandForceForPlanAndAck EXIT\n";
+    log(LogLevel::Info) << "plan corr=" << plan->correlationId << " DONE " << (allOk ? "OK" : "FAIL") << "\n";
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
 // SystemReactionForce (IWinnerFilter-Strategie für PFMEA-MSR-Systemreaktionen)
 // - Wird vom ReactionManager über CommandForceFactory::createSystemReactionFilter(...) genutzt.
 // - Für jeden Gewinner-FailureMode wird die SystemReaction-Payload aus dem KG geladen.
-// - PlanJsonUtils baut daraus einen CallMethod-Plan, optional mit DiagnoseFinished-Puls am Ende.
-// - CallMethod-Schritte werden über PLCMonitor::callMethodTyped ausgeführt; erwartete Outputs
-//   (expOuts) werden mit den realen UA-Outputs verglichen.
+// - PlanJsonUtils baut daraus einen CallMethod-Plan (gecachte Vorlage je IRI), optional mit
+//   DiagnoseFinished-Puls am Ende.
+// - Der Plan läuft gruppenweise über executeStepGroupsAsync (PlanExecutor): CallMethod-
+//   Schritte einer Schrittgruppe gebündelt in einem CallRequest (executeCallGroupAsync), die
+//   Schritte einer Gruppe gleichzeitig (bis maxParallel), Dauer je Schritt im Log; erwartete
+//   Outputs (expOuts) werden mit den realen UA-Outputs verglichen.
 // - Für einfache SPS-Schritte (PulseBool, WriteBool, WaitMs, Block/Unblock, Reroute) wird
-//   erneut CommandForceFactory::create(UseMonitor, ...) verwendet.
+//   erneut CommandForceFactory::create(UseMonitor, ...) verwendet, per executeAsync: Warte-
+//   zeiten laufen als Monitor-Timer, kein Thread schläft (der RM-Worker ist sofort frei).
 // - Über EventBus werden ReactionPlannedAck / ReactionDoneAck und SysReactFinishedAck gepostet.
 #include "SystemReactionForce.h"
 #include "PlanJsonUtils.h"
+#include "CallGroup.h"
+#include "PlanExecutor.h"
 #include "PLCMonitor.h"
 #include "EventBus.h"
 #include "Acks.h"
@@ -16,51 +22,223 @@
 #include "PLCCommandForce.h"
 #include "CommandForceFactory.h"  // falls du die Factory nutzen willst
 #include <format>
+#include <algorithm>
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <sstream>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// DiagnoseFinished-Puls ohne Preclear: keine Wartezeit im Aufrufer, LOW per Monitor-Timer
+void pulseDiagnoseFinished(PLCMonitor& mon, CorrelationId corr, const std::string& resourceId) {
+    auto cf = CommandForceFactory::create(CommandForceFactory::Kind::UseMonitor, mon);
+    Operation op;
+    op.type      = OpType::PulseBool;
+    op.nodeId    = "OPCUA.DiagnoseFinished";
+    op.ns        = 4;
+    op.timeoutMs = 100;           // Pulsbreite
+    Plan p;
+    p.correlationId = corr;
+    p.resourceId    = resourceId;
+    p.ops.push_back(op);
+    cf->executeAsync(p, [](int){});
+}
+
+// Zustand eines filterAsync-Laufs; unabhängig von der SystemReactionForce-Instanz.
+// Die Pläne laufen nacheinander, es greift also immer nur ein Thread zu.
+struct SysReactRun {
+    PLCMonitor*   mon = nullptr;
+    EventBus*     bus = nullptr;
+    unsigned      defTimeoutMs = 0;
+    unsigned      maxParallel  = 1;
+    CorrelationId corr;
+    std::string   processNameForAck;
+
+    struct Item {
+        std::string                 fm;
+        std::string                 iri;    // IRI-Header der Payload (SysReactFinishedAck)
+        std::shared_ptr<const Plan> plan;
+    };
+    std::vector<Item>        items;         // nur FMs mit Payload
+    size_t                   k = 0;         // aktueller Plan
+    std::vector<std::string> kept;
+    std::vector<std::string> executedSysSkillIris;
+    bool                     allOk = true;
+    IWinnerFilter::Done      done;
+};
+
+// Soll/Ist-Vergleich eines CallMethod-Schritts (Log am Stück: Schritte laufen parallel)
+bool checkCallStep(SysReactRun& r, const Plan& plan, size_t i, const CallStepResult& res) {
+    const auto& op = plan.ops[i];
+    const UAValueMap& got = res.got;
+    bool match = true;
+
+    std::ostringstream os;
+    // Log: expected vs got als ganze Maps
+    os << "[SysReact]   step#" << i << " expected=" << uaMapToJson(op.expOuts).dump()
+       << " got=" << uaMapToJson(got).dump() << "\n";
+
+    // kleiner Helper zum hübschen Einzelwert-Print mit Typ-Tag
+    auto valJson = [&](const UAValue& v) {
+        nlohmann::json j;
+        j["t"] = tagOf(v);
+        j["v"] = uaValueToJson(v);
+        return j;
+    };
+
+    if (!op.expOuts.empty()) {
+        for (const auto& [key, vexp] : op.expOuts) {
+            auto it = got.find(key);
+            const bool present = (it != got.end());
+            const bool okOne   = present && equalUA(vexp, it->second);
+            if (!okOne) match = false;
+
+            os << "[SysReact]   [CMP] out[" << key << "] "
+               << "exp=" << valJson(vexp).dump()
+               << " got=" << (present ? valJson(it->second).dump() : "\"<missing>\"")
+               << " -> " << (okOne ? "MATCH" : "DIFF") << "\n";
+        }
+    } else {
+        os << "[SysReact]   (no expected outputs specified; skipping compare)\n";
+    }
+
+    // Gesamtergebnis für diesen Schritt
+    const bool okThisStep = res.callOk && match;
+    os << "[SysReact]   -> step#" << i << " " << (okThisStep ? "OK" : "FAIL") << "\n";
+    std::cout << os.str();
+
+    if (!match) {
+        r.bus->post({ EventType::evProcessFail, Clock::now(),
+            ProcessFailAck{ r.corr, r.processNameForAck,
+                            std::string("Output mismatch at '") + op.callMethNodeId + "'" } });
+        pulseDiagnoseFinished(*r.mon, r.corr, plan.resourceId.empty() ? "PLC" : plan.resourceId);
+    }
+    return okThisStep;
+}
+
+// Plan k ausführen; die Fortsetzung startet Plan k+1, nach dem letzten folgen die Acks
+void runNextPlan(const std::shared_ptr<SysReactRun>& r) {
+    if (r->k >= r->items.size()) {
+        r->bus->post({ EventType::evSysReactFinished, Clock::now(),
+            SysReactFinishedAck{ r->corr, r->executedSysSkillIris } });
+        // Ack: DONE
+        r->bus->post({ EventType::evSRDone, Clock::now(),
+            ReactionDoneAck{ r->corr, r->allOk ? 1 : 0, r->allOk ? "OK" : "FAIL" } });
+        // Semantik wie bei MonitoringActionForce: „kept“ signalisiert Erfolg.
+        auto done = std::move(r->done);
+        if (done) done(std::move(r->kept));
+        return;
+    }
+
+    const std::shared_ptr<const Plan> plan = r->items[r->k].plan;
+    auto calls = std::make_shared<std::vector<CallStepResult>>(plan->ops.size());
+
+    // Ausführen – gruppenweise (PlanExecutor): CallMethod-Schritte einer Gruppe gehen als
+    // ein CallRequest raus, danach laufen die Schritte der Gruppe gleichzeitig
+    // (Soll/Ist-Vergleich bzw. Pulse/Writes/Waits); zwischen Gruppen eine Barriere.
+    auto prepare = [r, plan, calls](size_t b, size_t e, std::function<void()> go) {
+        for (size_t i = b; i < e; ++i) {
+            const auto& op = plan->ops[i];
+            if (op.type != OpType::CallMethod) continue;
+            const unsigned to = (op.timeoutMs > 0) ? (unsigned)op.timeoutMs : r->defTimeoutMs;
+
+            // --- Vorab-Log: Ziel + Inputs + Timeout
+            std::cout << "[SysReact] CallMethod step#" << i
+                    << " obj='"  << op.callObjNodeId
+                    << "' meth='"<< op.callMethNodeId
+                    << "' inputs=" << uaMapToJson(op.inputs).dump()
+                    << " timeout=" << to << "ms\n";
+        }
+        // OPC UA Call(s): eine Gruppe = ein CallRequest; ohne Call geht es sofort weiter
+        executeCallGroupAsync(*r->mon, plan->ops, b, e, r->defTimeoutMs,
+            [calls, b, go = std::move(go)](std::vector<CallStepResult> results) {
+                std::move(results.begin(), results.end(), calls->begin() + static_cast<std::ptrdiff_t>(b));
+                go();
+            });
+    };
+
+    auto step = [r, plan, calls](size_t i, std::function<void(bool)> fin) {
+        const auto& op = plan->ops[i];
+        if (op.type == OpType::CallMethod) {
+            fin(checkCallStep(*r, *plan, i, (*calls)[i]));
+            return;
+        }
+        if (op.type == OpType::PulseBool || op.type == OpType::WriteBool
+                || op.type == OpType::RerouteOrders || op.type == OpType::BlockResource
+                || op.type == OpType::UnblockResource || op.type == OpType::WaitMs) {
+            // Pulse/Writes usw. über CommandForce; Wartezeiten als Monitor-Timer
+            auto cf = CommandForceFactory::create(CommandForceFactory::Kind::UseMonitor, *r->mon);
+            cf->executeAsync(Plan{r->corr, plan->resourceId, {op}},
+                             [fin = std::move(fin)](int rc){ fin(rc != 0); });
+            return;
+        }
+        fin(true);
+    };
+
+    executeStepGroupsAsync(plan, std::move(step), r->maxParallel, std::move(prepare),
+        [r](PlanRunReport rep) {
+            std::cout << "[SysReact] timing " << rep.summary() << "\n";
+            const auto& it = r->items[r->k];
+            if (rep.ok) r->kept.push_back(it.fm);
+            r->allOk = r->allOk && rep.ok;
+            if (!it.iri.empty()) r->executedSysSkillIris.push_back(it.iri);
+            ++r->k;
+            runNextPlan(r);
+        });
+}
+} // namespace
 
 SystemReactionForce::SystemReactionForce(PLCMonitor& mon, EventBus& bus,
-                                         Fetcher fetch, unsigned defaultTimeoutMs)
-: mon_(mon), bus_(bus), fetch_(std::move(fetch)), defTimeoutMs_(defaultTimeoutMs) {}
+                                         Fetcher fetch, unsigned defaultTimeoutMs,
+                                         unsigned maxParallel)
+: mon_(mon), bus_(bus), fetch_(std::move(fetch)), defTimeoutMs_(defaultTimeoutMs),
+  maxParallel_((std::max)(maxParallel, 1u)) {}
 
 std::vector<std::string>
 SystemReactionForce::filter(const std::vector<std::string>& winners,
-                            const std::string& corr,
+                            CorrelationId corr,
                             const std::string& processNameForAck)
 {
-    using Clock = std::chrono::steady_clock;
+    std::promise<std::vector<std::string>> kept;
+    auto f = kept.get_future();
+    filterAsync(winners, corr, processNameForAck,
+                [&kept](std::vector<std::string> k){ kept.set_value(std::move(k)); });
+    return f.get();
+}
 
+void SystemReactionForce::filterAsync(const std::vector<std::string>& winners,
+                                      CorrelationId corr,
+                                      const std::string& processNameForAck,
+                                      Done done)
+{
     // Ack: PLANNED (wie bei MonitoringActions, aber Summary passend)
     bus_.post({ EventType::evSRPlanned, Clock::now(),
-        std::any{ ReactionPlannedAck{ corr, "Station", "SystemReaction Plan (CallMethod)" } } });
+        ReactionPlannedAck{ corr, "Station", "SystemReaction Plan (CallMethod)" } });
 
-    std::vector<std::string> kept;
-    std::vector<std::string> executedSysSkillIris;   // NEU
-    kept.reserve(winners.size());
-
-    bool allOk = true;
+    auto r = std::make_shared<SysReactRun>();
+    r->mon               = &mon_;
+    r->bus               = &bus_;
+    r->defTimeoutMs      = defTimeoutMs_;
+    r->maxParallel       = maxParallel_;
+    r->corr              = corr;
+    r->processNameForAck = processNameForAck;
+    r->done              = std::move(done);
+    r->items.reserve(winners.size());
+    r->kept.reserve(winners.size());
 
+    // 1) SystemReaction-Payloads holen (KG) – hier im Aufrufer, nie im UA-Thread
     for (const auto& fm : winners) {
-        // 1) SystemReaction-Payload holen (KG)
         const std::string payload = fetch_(fm);
         if (payload.empty()) {
             // Ohne Payload: als „Fehler“ werten
             bus_.post({ EventType::evProcessFail, Clock::now(),
-                        std::any{ ProcessFailAck{ corr, processNameForAck,
-                                                  "No system reaction defined for this failure." } } });
-            allOk = false;
-            
-            auto cf = CommandForceFactory::create(CommandForceFactory::Kind::UseMonitor, mon_);
-            Operation op;
-            op.type = OpType::PulseBool;
-            op.nodeId = "OPCUA.DiagnoseFinished";
-            op.ns = 4;
-            op.timeoutMs = 100;
-            Plan p;
-            p.correlationId = corr;
-            p.resourceId    = "egal";
-            p.ops.push_back(op);
-            cf->execute(p);
+                        ProcessFailAck{ corr, processNameForAck,
+                                        "No system reaction defined for this failure." } });
+            r->allOk = false;
+            pulseDiagnoseFinished(mon_, corr, "egal");
             continue;
         }
         //Zu ausgeführten Systemreaktionen hinzufügen
@@ -72,100 +250,11 @@ SystemReactionForce::filter(const std::vector<std::string>& winners,
             while(!iri.empty() && (iri.back()=='\r'||iri.back()=='\n'||iri.back()==' '||iri.back()=='\t')) iri.pop_back();
         }
 
-        // 2) Plan bauen -> mit DiagnoseFinished-Puls am Ende
-        Plan plan = buildCallMethodPlanFromPayload(corr, payload, /*appendPulse=*/true,"Station");
-        bool okThis = true;
-
-        // 3) Ausführen
-        for (size_t i = 0; i < plan.ops.size(); ++i) {
-            const auto& op = plan.ops[i];
-            if (op.type == OpType::CallMethod) {
-                const unsigned to = (op.timeoutMs > 0) ? (unsigned)op.timeoutMs : defTimeoutMs_;
-
-                // --- Vorab-Log: Ziel + Inputs + Timeout
-                std::cout << "[SysReact] CallMethod step#" << i
-                        << " obj='"  << op.callObjNodeId
-                        << "' meth='"<< op.callMethNodeId
-                        << "' inputs=" << uaMapToJson(op.inputs).dump()
-                        << " timeout=" << to << "ms\n";
-
-                // 1) OPC UA Call (typisiert, mehrere Outputs möglich)
-                UAValueMap got;
-                const bool callOk = mon_.callMethodTyped(op.callObjNodeId, op.callMethNodeId,
-                                                        op.inputs, got, to);
-
-                // 2) Soll/Ist-Vergleich (nur Keys aus expOuts müssen matchen)
-                bool match = true;
-
-                // Log: expected vs got als ganze Maps
-                std::cout << "[SysReact]   expected=" << uaMapToJson(op.expOuts).dump()
-                        << " got=" << uaMapToJson(got).dump() << "\n";
-
-                // kleiner Helper zum hübschen Einzelwert-Print mit Typ-Tag
-                auto valJson = [&](const UAValue& v) {
-                    nlohmann::json j;
-                    j["t"] = tagOf(v);
-                    j["v"] = uaValueToJson(v);
-                    return j;
-                };
-
-                if (!op.expOuts.empty()) {
-                    for (const auto& [k, vexp] : op.expOuts) {
-                        auto it = got.find(k);
-                        const bool present = (it != got.end());
-                        const bool okOne   = present && equalUA(vexp, it->second);
-                        if (!okOne) match = false;
-
-                        std::cout << "[SysReact]   [CMP] out[" << k << "] "
-                                << "exp=" << valJson(vexp).dump()
-                                << " got=" << (present ? valJson(it->second).dump() : "\"<missing>\"")
-                                << " -> " << (okOne ? "MATCH" : "DIFF") << "\n";
-                    }
-                } else {
-                    std::cout << "[SysReact]   (no expected outputs specified; skipping compare)\n";
-                }
-
-                if (!match) {
-                    bus_.post({ EventType::evProcessFail, std::chrono::steady_clock::now(),
-                        std::any{ ProcessFailAck{ corr, processNameForAck,
-                                                std::string("Output mismatch at '") + op.callMethNodeId + "'" } } });
-
-                    auto cf = CommandForceFactory::create(CommandForceFactory::Kind::UseMonitor, mon_);
-                    Operation op;
-                    op.type      = OpType::PulseBool;
-                    op.ns        = 4;
-                    op.nodeId    = "OPCUA.DiagnoseFinished";
-                    op.timeoutMs = 100;           // Pulsbreite
-                    Plan p;
-                    p.correlationId = plan.correlationId;
-                    p.resourceId    = plan.resourceId.empty()? "PLC" : plan.resourceId;
-                    p.ops.push_back(op);
-                    cf->execute(p);
-                }
-                // Gesamtergebnis für diesen Schritt
-                const bool okThisStep = callOk && match;
-                std::cout << "[SysReact]   -> step#" << i << " " << (okThisStep ? "OK" : "FAIL") << "\n";
-
-                okThis = okThis && okThisStep;
-            }
-            else if (op.type == OpType::PulseBool || op.type == OpType::WriteBool
-                    || op.type == OpType::RerouteOrders || op.type == OpType::BlockResource
-                    || op.type == OpType::UnblockResource || op.type == OpType::WaitMs) {
-                // Für Pulse/Writes usw. nutzt du wie bisher CommandForce
-                auto cf = CommandForceFactory::create(CommandForceFactory::Kind::UseMonitor, mon_);
-                okThis = okThis && (cf->execute(Plan{corr, plan.resourceId, {op}}) != 0);
-            }
-        }
-        if (okThis) kept.push_back(fm);
-        allOk = allOk && okThis;
-        if (!iri.empty()) executedSysSkillIris.push_back(iri);
+        // 2) Plan -> mit DiagnoseFinished-Puls am Ende (gecachte Vorlage, CorrelationId = corr)
+        r->items.push_back({ fm, std::move(iri),
+                             compiledCallMethodPlan(payload, /*appendPulse=*/true, "Station") });
     }
-    bus_.post({ EventType::evSysReactFinished, Clock::now(),
-        std::any{ SysReactFinishedAck{ corr, executedSysSkillIris } } });
-    // Ack: DONE
-    bus_.post({ EventType::evSRDone, Clock::now(),
-        std::any{ ReactionDoneAck{ corr, allOk ? 1 : 0, allOk ? "OK" : "FAIL" } } });
-
-    // Semantik wie bei MonitoringActionForce: „kept“ signalisiert Erfolg.
-    return kept;
-}
\ No newline at end of file
+
+    // 3) Pläne nacheinander ausführen, ohne den Aufrufer zu blockieren
+    runNextPlan(r);
+}
@@ -56,27 +56,18 @@ const char* TimeBlogger::toName_(EventType t) {
     return "ev";
 }
 
-std::string TimeBlogger::extractCorrId_(const Event& ev) {
-    // Acks
-    if (auto p = std::any_cast<ReactionPlannedAck>(&ev.payload))    return p->correlationId;
-    if (auto p = std::any_cast<ReactionDoneAck>(&ev.payload))       return p->correlationId;
-    if (auto p = std::any_cast<ProcessFailAck>(&ev.payload))        return p->correlationId;
-    if (auto p = std::any_cast<IngestionPlannedAck>(&ev.payload))   return p->correlationId;
-    if (auto p = std::any_cast<IngestionDoneAck>(&ev.payload))      return p->correlationId;
-    if (auto p = std::any_cast<MonActFinishedAck>(&ev.payload))     return p->correlationId;
-    if (auto p = std::any_cast<SysReactFinishedAck>(&ev.payload))   return p->correlationId;
-    if (auto p = std::any_cast<UnknownFMAck>(&ev.payload))          return p->correlationId;
-    if (auto p = std::any_cast<GotFMAck>(&ev.payload))              return p->correlationId;
-
-
-    if (auto p = std::any_cast<PLCSnapshotPayload>(&ev.payload))    return p->correlationId; // Event.h 
-
-    return "ev-" + std::to_string(static_cast<int>(ev.type));
+CorrelationId TimeBlogger::extractCorrId_(const Event& ev) {
+    // correlationId steckt direkt im Event (aus der typisierten Payload übernommen)
+    if (ev.correlationId.valid()) return ev.correlationId;
+    // ohne Id: eine Timeline je EventType (Text "ev-0-<type+1>")
+    CorrelationId c;
+    c.seq = static_cast<std::uint32_t>(ev.type) + 1;
+    return c;
 }
 
 void TimeBlogger::onEvent(const Event& ev) {
     const char* evName = toName_(ev.type);
-    const std::string corr = extractCorrId_(ev);
+    const CorrelationId corr = extractCorrId_(ev);
 
     DurationMs dtSincePrev{0};
     long long durMs = 0;
@@ -107,7 +98,7 @@ void TimeBlogger::onEvent(const Event& ev) {
     }
 }
 
-void TimeBlogger::handleEvent_(const Event& ev, const std::string& corrId, const char* evName) {
+void TimeBlogger::handleEvent_(const Event& ev, CorrelationId corrId, const char* evName) {
     std::lock_guard<std::mutex> lk(mx_);
     auto it = tlByCorr_.find(corrId);
     if (it == tlByCorr_.end()) return;
@@ -129,7 +120,7 @@ void TimeBlogger::recordSegment_(Timeline& tl, const std::string& from, const st
     std::cout << "[Time][seg] " << from << "->" << to << " = " << ms.count() << " ms\n";
 }
 
-void TimeBlogger::mark(const std::string& corrId, const std::string& label) {
+void TimeBlogger::mark(CorrelationId corrId, const std::string& label) {
     std::lock_guard<std::mutex> lk(mx_);
     auto& tl = tlByCorr_[corrId];
     const auto now = Clock::now();
@@ -140,7 +131,7 @@ void TimeBlogger::mark(const std::string& corrId, const std::string& label) {
     tl.hasLast       = true;
 }
 
-bool TimeBlogger::delta(const std::string& corrId, const std::string& fromLabel,
+bool TimeBlogger::delta(CorrelationId corrId, const std::string& fromLabel,
                         const std::string& toLabel, DurationMs& out) const {
     std::lock_guard<std::mutex> lk(mx_);
     auto ti = tlByCorr_.find(corrId);
@@ -153,7 +144,7 @@ bool TimeBlogger::delta(const std::string& corrId, const std::string& fromLabel,
     return true;
 }
 
-void TimeBlogger::finish(const std::string& corrId) {
+void TimeBlogger::finish(CorrelationId corrId) {
   std::vector<::CsvRow> rows;
   {
     std::lock_guard<std::mutex> lk(mx_);
@@ -188,7 +179,7 @@ void TimeBlogger::finish(const std::string& corrId) {
   }
 }
 
-void TimeBlogger::printAndCollect_(const std::string& corr,
+void TimeBlogger::printAndCollect_(CorrelationId corr,
                                    const std::string& evName,
                                    long long durMs,
                                    long long sumMs)
@@ -55,7 +55,7 @@ int WriteCSVForce::execute(const Plan& p) {
     ofs << "corrrelID,EventType,duration,DurSum\r\n"; // Header nur einmal (CRLF lt. RFC 4180)
   }
   for (const auto& r : prm->rows) {
-    ofs  << csvEscape(r.corrId)    << ','
+    ofs  << csvEscape(r.corrId.str()) << ','
          << csvEscape(r.eventType) << ','
          << r.durationMs           << ','
          << r.durSumMs             << "\r\n";
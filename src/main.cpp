@@ -7,6 +7,7 @@
 #include "AckLogger.h"
 #include "PythonRuntime.h"
 #include "PythonWorker.h"
+#include "KGIndex.h"
 #include <atomic>
 #include <chrono>
 #include <iostream>
@@ -14,6 +15,7 @@
 #include <pybind11/embed.h>
 #include "InventorySnapshot.h"
 #include "InventorySnapshotUtils.h"
+#include "Correlation.h"
 #include "FailureRecorder.h"
 #include "TimeBlogger.h"
 
@@ -30,8 +32,10 @@ int main() {
     main_gil_release = std::make_unique<py::gil_scoped_release>();
     //py::gil_scoped_release main_gil_release;
 
-    // PythonWorker starten
-    PythonWorker::instance().start();
+    // PythonWorker starten: 2 Threads, damit ein kurzer KG-Lookup (High) neben einem
+    // laufenden Job starten kann statt in der Queue zu warten. Abfragen laufen dann
+    // verzahnt unter einem GIL; eine Ingestion sperrt den Graphen nur kurz exklusiv.
+    PythonWorker::instance().start(2);
 
     PythonWorker::instance().call([]{
         namespace py = pybind11;
@@ -66,6 +70,15 @@ int main() {
         std::cout << "[KG] warm-up import done\n";
     });
 
+    // 5b) Langlebige KG-Session: TTL einmal parsen, Queries vorbereiten und aufwärmen
+#if defined(KG_SRC_DIR) && defined(KG_TTL_PATH)
+    PythonWorker::instance().startKgSession(KG_SRC_DIR, KG_TTL_PATH);
+    // 5c) Nativer KG-Index für die Lookups des ReactionManager (Python nur noch für Ingestion)
+    KGIndex::instance().loadTurtleFile(KG_TTL_PATH);
+#else
+    PythonWorker::instance().startKgSession({});
+#endif
+
     PLCMonitor::Options opt;
     opt.endpoint       = "opc.tcp://DESKTOP-LNJR8E0:4840";
     opt.username       = "VDAdmin";
@@ -82,8 +95,14 @@ int main() {
     }
     std::cout << "[Client] connected\n";
 
+    // Live-Spiegel aller Snapshot-Variablen (Slots der NodeTable): Snapshots ohne Read-Sturm
+    if (!startValueMirrorFor(mon, "PLC"))
+        std::cout << "[Client] Live-Spiegel nicht aktiv -> Snapshots lesen per Batch-Read\n";
+
     // 6) EventBus + ReactionManager + Logger + Abos
     EventBus bus;
+    // Ohne Dispatch-Thread weckt bus.post() den Main-Loop, der dann process() aufruft
+    bus.setWakeHook([&mon]{ mon.wakeup(); });
     auto rm        = std::make_shared<ReactionManager>(mon, bus);
     rm->setLogLevel(ReactionManager::LogLevel::Info);
     auto subD2     = bus.subscribe_scoped(EventType::evD2, rm, 4);
@@ -118,18 +137,19 @@ int main() {
             if (!b) { prev = false; return; }
             if (prev.exchange(true)) return;
 
-            mon.post([&]{
+            const UA_DateTime edgeTs = dv.hasSourceTimestamp ? dv.sourceTimestamp : dv.serverTimestamp;
+            mon.post([&, edgeTs]{
                 InventorySnapshot inv;
-                const bool ok = buildInventorySnapshotNow(mon, "PLC", inv);
+                const bool ok = buildInventorySnapshotNow(mon, "PLC", inv, edgeTs);
                 std::cout << "[Debug] Snapshot D3 = " << (ok ? "OK":"FAIL") << "\n";
                 dumpInventorySnapshot(inv);
 
                 const auto now = std::chrono::steady_clock::now();
-                const std::string corr = "evD3-" + std::to_string(now.time_since_epoch().count());
+                const CorrelationId corr = makeCorrelationId(CorrSource::D3);
 
-                bus.post({ EventType::evD3, now, std::any{ D2Snapshot{ corr, std::move(inv) } } });
+                bus.post({ EventType::evD3, now, D2Snapshot{ corr, shareSnapshot(std::move(inv)) } });
                 bus.post({ EventType::evUnknownFM, now,
-                        std::any{ UnknownFMAck{ corr, "UnknownFM", "Triggered by D3" } } });
+                        UnknownFMAck{ corr, "UnknownFM", "Triggered by D3" } });
             });
         });
     mon.subscribeBool("OPCUA.TriggerD1", opt.nsIndex, 0.0, 10,
@@ -146,18 +166,19 @@ int main() {
             if (!b) { prev = false; return; }
             if (prev.exchange(true)) return;
 
-            mon.post([&]{
+            const UA_DateTime edgeTs = dv.hasSourceTimestamp ? dv.sourceTimestamp : dv.serverTimestamp;
+            mon.post([&, edgeTs]{
                 InventorySnapshot inv;
-                const bool ok = buildInventorySnapshotNow(mon, "PLC", inv);
+                const bool ok = buildInventorySnapshotNow(mon, "PLC", inv, edgeTs);
                 std::cout << "[Debug] Snapshot D1 = " << (ok ? "OK":"FAIL") << "\n";
                 dumpInventorySnapshot(inv);
 
                 const auto now = std::chrono::steady_clock::now();
-                const std::string corr = "evD1-" + std::to_string(now.time_since_epoch().count());
+                const CorrelationId corr = makeCorrelationId(CorrSource::D1);
 
-                bus.post({ EventType::evD1, now, std::any{ D2Snapshot{ corr, std::move(inv) } } });
+                bus.post({ EventType::evD1, now, D2Snapshot{ corr, shareSnapshot(std::move(inv)) } });
                 bus.post({ EventType::evUnknownFM, now,
-                        std::any{ UnknownFMAck{ corr, "UnknownFM", "Triggered by D1" } } });
+                        UnknownFMAck{ corr, "UnknownFM", "Triggered by D1" } });
             });
         });
     mon.subscribeBool("OPCUA.TriggerD2", opt.nsIndex, 0.0, 10,
@@ -174,18 +195,19 @@ int main() {
             if (!b) { prev = false; return; }
             if (prev.exchange(true)) return;
 
-            mon.post([&]{
+            const UA_DateTime edgeTs = dv.hasSourceTimestamp ? dv.sourceTimestamp : dv.serverTimestamp;
+            mon.post([&, edgeTs]{
                 InventorySnapshot inv;
-                const bool ok = buildInventorySnapshotNow(mon, "PLC", inv);
+                const bool ok = buildInventorySnapshotNow(mon, "PLC", inv, edgeTs);
                 std::cout << "[Debug] Snapshot D2 = " << (ok ? "OK":"FAIL") << "\n";
                 dumpInventorySnapshot(inv);
 
                 const auto now = std::chrono::steady_clock::now();
-                const std::string corr = "evD2-" + std::to_string(now.time_since_epoch().count());
+                const CorrelationId corr = makeCorrelationId(CorrSource::D2);
 
-                bus.post({ EventType::evD2, now, std::any{ D2Snapshot{ corr, std::move(inv) } } });
+                bus.post({ EventType::evD2, now, D2Snapshot{ corr, shareSnapshot(std::move(inv)) } });
                 bus.post({ EventType::evUnknownFM, now,
-                        std::any{ UnknownFMAck{ corr, "UnknownFM", "Triggered by D2" } } });
+                        UnknownFMAck{ corr, "UnknownFM", "Triggered by D2" } });
             });
         });
     /*
@@ -201,10 +223,9 @@ int main() {
             std::cout << "[Debug] buildInventorySnapshotNow = " << (ok ? "OK":"FAIL") << "\n";
             dumpInventorySnapshot(inv);  // <— kompletter Dump hier
 
-            const std::string corr = "evD2-" + std::to_string(
-                std::chrono::steady_clock::now().time_since_epoch().count());
+            const CorrelationId corr = makeCorrelationId(CorrSource::D2);
             bus.post({ EventType::evD2, std::chrono::steady_clock::now(),
-                    std::any{ D2Snapshot{ corr, std::move(inv) } } });
+                    D2Snapshot{ corr, shareSnapshot(std::move(inv)) } });
         });
     }); */
     std::cout << "[Client] subscribed: ns=4;s=TriggerD2\n";
@@ -212,12 +233,16 @@ int main() {
     auto tb = std::make_shared<TimeBlogger>(bus);
     tb->subscribeAll();
 
-    // 8) Main-Loop
+    // Events nicht mehr im Takt von runIterate(50) verteilen, sondern sofort auf eigenem Thread
+    bus.startDispatchThread();
+
+    // 8) Main-Loop (Reactor): schläft im EventLoop des UA-Clients, bis Socket-Daten,
+    //    mon.post()/postDelayed(), bus.post() (ohne Dispatch-Thread) oder der nächste Timer
+    //    anstehen; maxWaitMs ist nur die Obergrenze.
     for (;;) {
-        mon.runIterate(50);   
-        mon.processPosted(16);
-        bus.process(16);
-        // std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const bool busPending = !bus.dispatchThreadActive() && bus.hasPending();
+        mon.runOnce(busPending ? 0 : 250);
+        bus.process(256);     // no-op, solange der Dispatch-Thread läuft
     }
 
     // (Nie erreicht) PythonWorker::instance().stop();
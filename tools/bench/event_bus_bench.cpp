@@ -0,0 +1,186 @@
+// event_bus_bench.cpp
+// Misst den EventBus-Pfad post() -> onEvent():
+//  - "pumped":   Verteilung wie im alten Main-Loop (process(16) nach jeweils pumpMs Wartezeit,
+//                entspricht runIterate(50) ohne UA-Verkehr)
+//  - "dispatch": eigener Dispatch-Thread mit Wake-on-post
+// Je Modus: Latenz einzelner Events (Median/p99) und Durchsatz mit 1..N Producern.
+// Zusätzlich "fanout": reine Verteilkosten (post_now) mit 1..64 Subscribern je EventType,
+// vorsortierte RCU-Listen vs. altes Verfahren (Kopie unter Mutex + sort je Event).
+//
+// Aufruf: event_bus_bench [pumpMs] [events]   (Defaults: 50, 200000)
+
+#include "EventBus.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct LatencyObserver : ReactiveObserver {
+    std::mutex mx;
+    std::vector<double> us;
+    std::atomic<size_t> seen{0};
+    void onEvent(const Event& ev) override {
+        const auto dt = std::chrono::duration<double, std::micro>(Clock::now() - ev.ts).count();
+        { std::lock_guard<std::mutex> lk(mx); us.push_back(dt); }
+        seen.fetch_add(1, std::memory_order_release);
+    }
+};
+
+struct CountObserver : ReactiveObserver {
+    std::atomic<size_t> seen{0};
+    void onEvent(const Event&) override { seen.fetch_add(1, std::memory_order_release); }
+};
+
+// Simulierter Main-Loop für den Pump-Modus
+struct Pump {
+    EventBus& bus;
+    int pumpMs;
+    std::atomic<bool> run{true};
+    std::thread th;
+    Pump(EventBus& b, int ms) : bus(b), pumpMs(ms) {
+        th = std::thread([this]{
+            while (run.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(pumpMs));
+                bus.process(16);
+            }
+        });
+    }
+    ~Pump() { run = false; th.join(); }
+};
+
+// Nachbau des früheren dispatch_one() als Referenz für den Fanout-Vergleich
+struct LegacyDispatch {
+    struct Entry { std::weak_ptr<ReactiveObserver> wp; std::uint64_t id; int priority; };
+    std::mutex mx;
+    std::unordered_map<int, std::vector<Entry>> listeners;
+    void add(EventType t, const std::shared_ptr<ReactiveObserver>& o, std::uint64_t id, int prio) {
+        std::lock_guard<std::mutex> lk(mx);
+        listeners[static_cast<int>(t)].push_back(Entry{ o, id, prio });
+    }
+    void dispatch(const Event& ev) {
+        std::vector<Entry> copy;
+        {
+            std::lock_guard<std::mutex> lk(mx);
+            auto it = listeners.find(static_cast<int>(ev.type));
+            if (it == listeners.end()) return;
+            copy = it->second;
+        }
+        std::sort(copy.begin(), copy.end(), [](const Entry& a, const Entry& b){
+            if (a.priority != b.priority) return a.priority > b.priority;
+            return a.id < b.id;
+        });
+        for (const auto& e : copy) if (auto sp = e.wp.lock()) sp->onEvent(ev);
+    }
+};
+
+void runFanout(size_t subscribers, size_t reps) {
+    EventBus bus;
+    LegacyDispatch legacy;
+    std::vector<std::shared_ptr<CountObserver>> obs;
+    std::vector<Subscription> subs;
+    for (size_t i = 0; i < subscribers; ++i) {
+        obs.push_back(std::make_shared<CountObserver>());
+        const int prio = EventBus::kMinPriority + static_cast<int>(i % EventBus::kMaxPriority);
+        subs.push_back(bus.subscribe_scoped(EventType::evMonActDone, obs.back(), prio));
+        legacy.add(EventType::evMonActDone, obs.back(), i + 1, prio);
+    }
+    const Event ev{ EventType::evMonActDone, Clock::now(), {} };
+
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < reps; ++i) legacy.dispatch(ev);
+    const double legacyNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / reps;
+
+    t0 = Clock::now();
+    for (size_t i = 0; i < reps; ++i) bus.post_now(ev);
+    const double rcuNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / reps;
+
+    std::printf("%zu;%.0f;%.0f;%.2f\n", subscribers, legacyNs, rcuNs, legacyNs / rcuNs);
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    const size_t i = std::min(v.size() - 1, static_cast<size_t>(p * (v.size() - 1)));
+    return v[i];
+}
+
+void runLatency(const char* mode, bool dispatch, int pumpMs, size_t n,
+                std::chrono::microseconds gap) {
+    EventBus bus;
+    auto obs = std::make_shared<LatencyObserver>();
+    auto sub = bus.subscribe_scoped(EventType::evMonActDone, obs, 1);
+    std::unique_ptr<Pump> pump;
+    if (dispatch) bus.startDispatchThread();
+    else          pump = std::make_unique<Pump>(bus, pumpMs);
+
+    for (size_t i = 0; i < n; ++i) {
+        bus.post({ EventType::evMonActDone, Clock::now(), {} });
+        std::this_thread::sleep_for(gap);   // einzelne Events, kein Rückstau
+    }
+    while (obs->seen.load(std::memory_order_acquire) < n)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::lock_guard<std::mutex> lk(obs->mx);
+    std::printf("%s;latency;1;%zu;-;%.1f;%.1f\n", mode, n,
+                percentile(obs->us, 0.5), percentile(obs->us, 0.99));
+}
+
+void runThroughput(const char* mode, bool dispatch, int pumpMs, size_t producers, size_t total) {
+    EventBus bus;
+    auto obs = std::make_shared<CountObserver>();
+    auto sub = bus.subscribe_scoped(EventType::evMonActDone, obs, 1);
+    std::unique_ptr<Pump> pump;
+    if (dispatch) bus.startDispatchThread();
+    else          pump = std::make_unique<Pump>(bus, pumpMs);
+
+    const size_t per = total / producers;
+    const size_t n   = per * producers;
+    const auto t0 = Clock::now();
+    std::vector<std::thread> ths;
+    for (size_t p = 0; p < producers; ++p)
+        ths.emplace_back([&]{
+            for (size_t i = 0; i < per; ++i)
+                bus.post({ EventType::evMonActDone, Clock::now(), {} });
+        });
+    for (auto& t : ths) t.join();
+    while (obs->seen.load(std::memory_order_acquire) < n)
+        std::this_thread::yield();
+    const double s = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::printf("%s;throughput;%zu;%zu;%.0f;-;-\n", mode, producers, n, n / s);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int    pumpMs = argc > 1 ? std::atoi(argv[1]) : 50;
+    const size_t events = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+
+    std::printf("mode;test;producers;events;events_per_s;p50_us;p99_us\n");
+    // Pump-Modus: Abstand so wählen, dass process(16) je Takt nicht zurückfällt
+    runLatency("pumped",   false, pumpMs, 50,
+               std::chrono::microseconds((std::max)(500, pumpMs * 1000 / 8)));
+    runLatency("dispatch", true,  pumpMs, 2000, std::chrono::microseconds(500));
+
+    // Pump-Modus: bei 16 Events je pumpMs ist der Durchsatz gedeckelt -> kleine Menge
+    const size_t pumpedEvents = std::max<size_t>(16, 16 * 1000 / std::max(pumpMs, 1));
+    runThroughput("pumped", false, pumpMs, 1, pumpedEvents);
+    for (size_t p : { 1, 2, 4, 8 })
+        runThroughput("dispatch", true, pumpMs, p, events);
+
+    std::printf("\nsubscribers;legacy_ns_per_event;rcu_ns_per_event;speedup\n");
+    for (size_t n : { 1, 2, 4, 8, 16, 32, 64 })
+        runFanout(n, (std::max<size_t>)(1000, events / n));
+    return 0;
+}
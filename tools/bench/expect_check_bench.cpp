@@ -0,0 +1,168 @@
+// expect_check_bench.cpp
+// Auswahl der Failure-Mode-Kandidaten gegen einen D2-Snapshot (ohne PLC/KG):
+//  - "lookup":   alter Pfad – je Erwartung NodeTable-Lookup + switch, ComparisonReport
+//                mit Detail-String je Erwartung
+//  - "compiled": CompiledChecks – Kandidaten einmal in flache Slot/Soll-Arrays übersetzt,
+//                danach nur Spaltenzugriffe mit Early-out je Kandidat
+// Zusätzlich die einmaligen Kompilierkosten. Etwa jeder 50. Kandidat passt.
+//
+// Aufruf: expect_check_bench [candidates] [expects] [reps]   (Defaults: 300, 8, 2000)
+
+#include "CompiledChecks.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr size_t kVars = 1000;
+
+// Inventar wie vom Test-Server: Bool/Int16/String/Double im Wechsel
+InventorySnapshot makeSnapshot() {
+    InventorySnapshot inv;
+    auto nodes = std::make_shared<NodeTable>();
+    for (size_t i = 0; i < kVars; ++i)
+        nodes->intern(NodeKey{ 4, 's', "OPCUA.BenchVar_" + std::to_string(i) });
+    inv.reset(std::move(nodes));
+    for (uint32_t i = 0; i < kVars; ++i) {
+        switch (i % 4) {
+            case 0: inv.setBool(i, (i & 2) != 0); break;
+            case 1: inv.setInt16(i, static_cast<int16_t>(i)); break;
+            case 2: inv.setString(i, "Skill_" + std::to_string(i)); break;
+            case 3: inv.setFloat(i, i * 0.5); break;
+        }
+    }
+    return inv;
+}
+
+// Nachbau von ReactionManager::KgExpect/KgCandidate
+enum class KgValKind { Bool, Int16, Float64, String };
+struct KgExpect {
+    NodeKey     key;
+    KgValKind   kind{KgValKind::Bool};
+    bool        expectedBool{false};
+    int16_t     expectedI16{0};
+    double      expectedF64{0.0};
+    std::string expectedStr;
+};
+struct KgCandidate { std::string potFM; std::vector<KgExpect> expects; };
+
+// Kandidat c prüft `expects` Variablen; bei c % 50 != 0 weicht die letzte ab
+std::vector<KgCandidate> makeCandidates(size_t n, size_t expects) {
+    std::vector<KgCandidate> out;
+    for (size_t c = 0; c < n; ++c) {
+        KgCandidate k{ "http://example.org/fm#FM_" + std::to_string(c), {} };
+        for (size_t j = 0; j < expects; ++j) {
+            const uint32_t v = static_cast<uint32_t>((c * 7 + j * 13) % kVars);
+            const bool wrong = (j + 1 == expects) && (c % 50 != 0);
+            KgExpect e; e.key = NodeKey{ 4, 's', "OPCUA.BenchVar_" + std::to_string(v) };
+            switch (v % 4) {
+                case 0: e.kind = KgValKind::Bool;    e.expectedBool = ((v & 2) != 0) != wrong; break;
+                case 1: e.kind = KgValKind::Int16;   e.expectedI16  = static_cast<int16_t>(v + wrong); break;
+                case 2: e.kind = KgValKind::String;  e.expectedStr  = "Skill_" + std::to_string(v + wrong); break;
+                case 3: e.kind = KgValKind::Float64; e.expectedF64  = v * 0.5 + wrong; break;
+            }
+            k.expects.push_back(std::move(e));
+        }
+        out.push_back(std::move(k));
+    }
+    return out;
+}
+
+// Alter compareAgainstCache (ohne Logging)
+struct ComparisonItem { NodeKey key; bool ok{false}; std::string detail; };
+struct ComparisonReport { bool allOk{true}; std::vector<ComparisonItem> items; };
+
+ComparisonReport compareLookup(const InventorySnapshot& inv, const std::vector<KgExpect>& expects) {
+    ComparisonReport rep;
+    for (const auto& e : expects) {
+        ComparisonItem it; it.key = e.key;
+        const uint32_t slot = inv.slotOf(e.key);
+        switch (e.kind) {
+            case KgValKind::Bool:
+                if (inv.has(slot, VarKind::Bool)) { it.ok = (inv.colBool[slot] != 0) == e.expectedBool; if (!it.ok) it.detail = "bool diff"; }
+                else it.detail = "bool not in cache";
+                break;
+            case KgValKind::Int16:
+                if (inv.has(slot, VarKind::Int16)) { it.ok = inv.colI16[slot] == e.expectedI16; if (!it.ok) it.detail = "i16 diff"; }
+                else it.detail = "Int16 not in cache";
+                break;
+            case KgValKind::Float64:
+                if (inv.has(slot, VarKind::Float)) { it.ok = inv.colF64[slot] == e.expectedF64; if (!it.ok) it.detail = "f64 diff"; }
+                else it.detail = "Float64 not in cache";
+                break;
+            case KgValKind::String:
+                if (inv.has(slot, VarKind::String)) { it.ok = inv.colStr[slot] == e.expectedStr; if (!it.ok) it.detail = "str diff"; }
+                else it.detail = "str not in cache";
+                break;
+        }
+        rep.allOk = rep.allOk && it.ok;
+        rep.items.push_back(std::move(it));
+    }
+    return rep;
+}
+
+CompiledChecks compile(const NodeTablePtr& nodes, const std::vector<KgCandidate>& cands) {
+    CompiledChecks cc(nodes);
+    for (const auto& c : cands) {
+        cc.beginCandidate();
+        for (const auto& e : c.expects) {
+            switch (e.kind) {
+                case KgValKind::Bool:    cc.expectBool  (e.key, e.expectedBool); break;
+                case KgValKind::Int16:   cc.expectInt16 (e.key, e.expectedI16);  break;
+                case KgValKind::Float64: cc.expectFloat (e.key, e.expectedF64);  break;
+                case KgValKind::String:  cc.expectString(e.key, e.expectedStr);  break;
+            }
+        }
+    }
+    return cc;
+}
+
+template <class F>
+double medianUs(size_t reps, F&& f) {
+    std::vector<double> us;
+    us.reserve(reps);
+    for (size_t r = 0; r < reps; ++r) {
+        const auto t0 = Clock::now();
+        f();
+        us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+    }
+    std::sort(us.begin(), us.end());
+    return us[us.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t ncand   = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 300;
+    const size_t expects = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+    const size_t reps    = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 2000;
+
+    const InventorySnapshot inv = makeSnapshot();
+    const auto cands = makeCandidates(ncand, expects);
+
+    size_t winLookup = 0, winCompiled = 0;
+    const double lookupUs = medianUs(reps, [&]{
+        winLookup = 0;
+        for (const auto& c : cands) winLookup += compareLookup(inv, c.expects).allOk ? 1 : 0;
+    });
+
+    CompiledChecks cc;
+    const double compileUs = medianUs((std::max<size_t>)(1, reps / 20), [&]{ cc = compile(inv.nodes, cands); });
+
+    std::vector<uint8_t> ok;
+    const double compiledUs = medianUs(reps, [&]{
+        cc.evaluate(inv, ok);
+        winCompiled = static_cast<size_t>(std::count(ok.begin(), ok.end(), 1));
+    });
+
+    std::printf("candidates;expects;lookup_us;compiled_us;compile_once_us;speedup;winners;same\n");
+    std::printf("%zu;%zu;%.1f;%.1f;%.1f;%.1f;%zu;%s\n", ncand, expects, lookupUs, compiledUs,
+                compileUs, lookupUs / compiledUs, winCompiled, winLookup == winCompiled ? "yes" : "NO");
+    return 0;
+}
@@ -0,0 +1,107 @@
+// kg_index_bench.cpp
+// Vergleicht die drei KG-Lookups des ReactionManager:
+//   rdflib – langlebige KGInterface-Session (vorbereitete SPARQL-Queries, eingebettetes Python)
+//   native – KGIndex (internierte IRIs, vorberechnete Antworten)
+// für die 100/500-Trip-KGs, inkl. Prüfung, dass beide Pfade dieselben Zeilen liefern.
+//
+// Aufruf: kg_index_bench [skill] [reps]   (Default: TestSkill1, 200)
+
+#include "KGIndex.h"
+#include <pybind11/embed.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double medianUs(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+double timeUs(const std::function<void()>& f) {
+    const auto t0 = Clock::now();
+    f();
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+}
+
+// Zeilen als Paare (IRI, Params) sortiert – Reihenfolge ist bei SPARQL nicht definiert.
+std::vector<std::string> normalized(const std::string& text) {
+    std::vector<std::string> lines, pairs;
+    std::istringstream is(text);
+    std::string l, cur;
+    // IRI-Zeilen beginnen einen neuen Eintrag, alles dazwischen gehört zu den Params
+    while (std::getline(is, l)) {
+        if (l.rfind("http", 0) == 0 && !cur.empty()) { pairs.push_back(cur); cur.clear(); }
+        cur += l; cur += '\n';
+    }
+    if (!cur.empty()) pairs.push_back(cur);
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string skill = (argc > 1) ? argv[1] : "TestSkill1";
+    const int reps          = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 200;
+    const std::string srcDir = KG_SRC_DIR;
+
+    py::scoped_interpreter guard{};
+    py::module_::import("sys").attr("path").attr("insert")(0, srcDir);
+    py::module_ mod = py::module_::import("KG_Interface");
+
+    std::cout << "kg;query;rdflib_us;native_us;speedup;same\n";
+    for (const char* file : { "FMEA_KG_augmented_100_trip.ttl", "FMEA_KG_augmented_500_trip.ttl" }) {
+        const std::string path = srcDir + "/" + file;
+
+        auto& idx = KGIndex::instance();
+        if (!idx.loadTurtleFile(path)) return 1;
+        py::object kgi = mod.attr("KGInterface")(path);
+        kgi.attr("warmUp")();
+
+        std::vector<KGIndex::Entry> fms;
+        idx.failureModesForSkill(skill, fms);
+        const std::string fm = fms.empty() ? std::string{} : fms.front().iri;
+
+        struct Q {
+            const char* name;
+            const char* pyMethod;
+            std::string arg;
+            std::function<void(std::string&)> native;
+        };
+        const std::vector<Q> queries = {
+            { "getFailureModeParameters", "getFailureModeParameters", skill,
+              [&](std::string& o){ idx.failureModeParameters(skill, o); } },
+            { "getMonitoringActionForFailureMode", "getMonitoringActionForFailureMode", fm,
+              [&](std::string& o){ idx.monitoringActionsForFM(fm, o); } },
+            { "getSystemreactionForFailureMode", "getSystemreactionForFailureMode", fm,
+              [&](std::string& o){ idx.systemReactionsForFM(fm, o); } },
+        };
+
+        // Schleife: je Query beide Pfade messen (Median) und Ergebnis vergleichen.
+        for (const auto& q : queries) {
+            std::string pyOut, nativeOut;
+            std::vector<double> tp, tn;
+            for (int r = 0; r < reps; ++r) {
+                tp.push_back(timeUs([&]{ pyOut = py::str(kgi.attr(q.pyMethod)(q.arg)); }));
+                tn.push_back(timeUs([&]{ q.native(nativeOut); }));
+            }
+            const double p = medianUs(tp), n = medianUs(tn);
+            const bool same = normalized(pyOut) == normalized(nativeOut);
+            std::cout << file << ";" << q.name << ";" << p << ";" << n << ";"
+                      << (n > 0.0 ? p / n : 0.0) << ";" << (same ? "yes" : "NO") << "\n";
+        }
+    }
+    return 0;
+}
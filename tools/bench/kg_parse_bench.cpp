@@ -0,0 +1,143 @@
+// kg_parse_bench.cpp
+// Einlesen der potFM-Kandidatenliste (getFailureModeParameters) in KgCandidate/KgExpect:
+//  - "dom":    alter Pfad – substr-Kopien je IRI/JSON-Block, nlohmann::json::parse je Block,
+//              Typ-Tag per std::transform klein geschrieben
+//  - "stream": parseKgCandidates – ein Durchlauf per std::string_view, ohne DOM
+// Die Antwort kommt aus dem nativen KGIndex (gleiches Format wie KG_Interface.py) für die
+// 100/500-Trip-KGs; "same" prüft, dass beide Pfade dieselben Kandidaten liefern.
+//
+// Aufruf: kg_parse_bench [skill] [reps]   (Default: TestSkill1, 200)
+
+#include "KGIndex.h"
+#include "KgResponseParser.h"
+#include "NodeIdUtils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using json  = nlohmann::json;
+
+namespace {
+
+// Nachbau von ReactionManager::normalizeKgResponse (vor KgResponseParser)
+std::vector<KgExpect> legacyExpects(const std::string& rowsJson) {
+    std::vector<KgExpect> out;
+    if (rowsJson.empty()) return out;
+    json j;
+    try { j = json::parse(rowsJson); } catch (...) { return out; }
+    json rows;
+    if (j.is_object()) rows = j;
+    else if (j.is_array() && !j.empty() && j[0].is_object()) rows = j[0];
+    else if (j.is_array() && j.size() >= 2 && j[1].is_object()) rows = j[1];
+    else return out;
+    auto arrIt = rows.find("rows");
+    if (arrIt == rows.end() || !arrIt->is_array()) return out;
+    for (const auto& r : *arrIt) {
+        if (!r.contains("id") || !r.contains("t") || !r.contains("v")) continue;
+        const std::string idText = r["id"].get<std::string>();
+        std::string t = r["t"].get<std::string>();
+        std::transform(t.begin(), t.end(), t.begin(),
+                       [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
+        uint16_t ns = 4; std::string idStr; char idType = 's';
+        if (!parseNsAndId(idText, ns, idStr, idType)) { idStr = idText; idType = 's'; }
+        KgExpect e; e.key = NodeKey{ ns, idType, idStr };
+        if      (t=="b" || t=="bool" || t=="boolean")         { e.kind = KgValKind::Bool;    e.expectedBool = r["v"].get<bool>(); }
+        else if (t=="i" || t=="int" || t=="int16" || t=="i16") { e.kind = KgValKind::Int16;   e.expectedI16  = r["v"].get<int16_t>(); }
+        else if (t=="f" || t=="float" || t=="double")          { e.kind = KgValKind::Float64; e.expectedF64  = r["v"].get<double>(); }
+        else                                                    { e.kind = KgValKind::String;  e.expectedStr  = r["v"].get<std::string>(); }
+        out.push_back(std::move(e));
+    }
+    return out;
+}
+
+// Nachbau von ReactionManager::normalizeKgPotFM (vor KgResponseParser), ohne Logs
+std::vector<KgCandidate> legacyCandidates(const std::string& srows) {
+    std::vector<KgCandidate> out;
+    std::string s = srows;
+    if (s.size() >= 2 && s.front() == '"' && s.back() == '"') s = s.substr(1, s.size() - 2);
+    auto skipWS = [&](size_t& p) { while (p < s.size() && std::isspace(static_cast<unsigned char>(s[p]))) ++p; };
+    size_t pos = 0;
+    while (true) {
+        skipWS(pos);
+        if (pos >= s.size()) break;
+        const size_t eol = s.find_first_of("\r\n", pos);
+        std::string iri = (eol == std::string::npos) ? s.substr(pos) : s.substr(pos, eol - pos);
+        const size_t a = iri.find_first_not_of(" \t"), b = iri.find_last_not_of(" \t");
+        iri = (a == std::string::npos) ? std::string{} : iri.substr(a, b - a + 1);
+        pos = (eol == std::string::npos) ? s.size() : eol;
+        skipWS(pos);
+        if (pos >= s.size() || s[pos] != '{') continue;
+        const size_t start = pos;
+        int depth = 0; bool inStr = false, esc = false;
+        for (; pos < s.size(); ++pos) {
+            const char c = s[pos];
+            if (inStr) { if (esc) esc = false; else if (c == '\\') esc = true; else if (c == '"') inStr = false; continue; }
+            if (c == '"') { inStr = true; continue; }
+            if (c == '{') { ++depth; continue; }
+            if (c == '}' && --depth == 0) { ++pos; break; }
+        }
+        out.push_back(KgCandidate{ iri, legacyExpects(s.substr(start, pos - start)) });
+    }
+    return out;
+}
+
+bool sameExpect(const KgExpect& a, const KgExpect& b) {
+    return a.key == b.key && a.kind == b.kind && a.expectedBool == b.expectedBool
+        && a.expectedI16 == b.expectedI16 && a.expectedF64 == b.expectedF64
+        && a.expectedStr == b.expectedStr;
+}
+
+bool sameCandidates(const std::vector<KgCandidate>& a, const std::vector<KgCandidate>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].potFM != b[i].potFM || a[i].expects.size() != b[i].expects.size()) return false;
+        for (size_t k = 0; k < a[i].expects.size(); ++k)
+            if (!sameExpect(a[i].expects[k], b[i].expects[k])) return false;
+    }
+    return true;
+}
+
+template <class F>
+double medianUs(int reps, F&& f) {
+    std::vector<double> us;
+    us.reserve(reps);
+    for (int r = 0; r < reps; ++r) {
+        const auto t0 = Clock::now();
+        f();
+        us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+    }
+    std::sort(us.begin(), us.end());
+    return us[us.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string skill  = (argc > 1) ? argv[1] : "TestSkill1";
+    const int reps           = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 200;
+    const std::string srcDir = KG_SRC_DIR;
+
+    std::printf("kg;bytes;candidates;expects;dom_us;stream_us;speedup;same\n");
+    for (const char* file : { "FMEA_KG_augmented_100_trip.ttl", "FMEA_KG_augmented_500_trip.ttl" }) {
+        auto& idx = KGIndex::instance();
+        if (!idx.loadTurtleFile(srcDir + "/" + file)) return 1;
+        std::string srows;
+        idx.failureModeParameters(skill, srows);
+
+        std::vector<KgCandidate> dom, stream;
+        const double d = medianUs(reps, [&]{ dom    = legacyCandidates(srows); });
+        const double s = medianUs(reps, [&]{ stream = parseKgCandidates(srows); });
+
+        size_t expects = 0;
+        for (const auto& c : stream) expects += c.expects.size();
+        std::printf("%s;%zu;%zu;%zu;%.1f;%.1f;%.1f;%s\n", file, srows.size(), stream.size(), expects,
+                    d, s, s > 0.0 ? d / s : 0.0, sameCandidates(dom, stream) ? "yes" : "NO");
+    }
+    return 0;
+}
@@ -0,0 +1,71 @@
+# kg_query_bench.py
+# Misst die Latenz der drei KG-Lookups (FailureModeParameters, MonitoringAction,
+# SystemReaction) für die 100/500-Trip-KGs:
+#   cold    – bisheriger Pfad: neue KGInterface-Instanz je Abfrage (TTL parsen + Query)
+#   session – langlebige KGInterface-Instanz mit vorbereiteten Queries (PythonWorker)
+#
+# Aufruf: python kg_query_bench.py [reps] [cold_reps]
+import statistics
+import sys
+import time
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parents[2]
+sys.path.insert(0, str(ROOT / "src"))
+
+from KG_Interface import KGInterface  # noqa: E402
+from rdflib import RDF                 # noqa: E402
+
+KG_FILES = ["FMEA_KG_augmented_100_trip.ttl", "FMEA_KG_augmented_500_trip.ttl"]
+
+
+def ms(f):
+    t0 = time.perf_counter()
+    f()
+    return (time.perf_counter() - t0) * 1000.0
+
+
+def probes(kgi: KGInterface):
+    """Ein Skill mit FailureModes und dessen erster FailureMode als Abfrage-Argumente."""
+    prefix = kgi.ont_iri
+    for fm in kgi.graph.subjects(RDF.type, kgi.CL.FailureMode):
+        for skill in kgi.graph.objects(fm, kgi.OP.preventsFunction):
+            s = str(skill)
+            if s.startswith(prefix):
+                return s[len(prefix):], str(fm)
+    return "", ""
+
+
+def bench(ttl: Path, reps: int, cold_reps: int):
+    t0 = time.perf_counter()
+    kgi = KGInterface(str(ttl))
+    load_ms = (time.perf_counter() - t0) * 1000.0
+    warm_ms = ms(kgi.warmUp)
+    skill, fm = probes(kgi)
+
+    queries = {
+        "getFailureModeParameters":          lambda k: k.getFailureModeParameters(skill),
+        "getMonitoringActionForFailureMode": lambda k: k.getMonitoringActionForFailureMode(fm),
+        "getSystemreactionForFailureMode":   lambda k: k.getSystemreactionForFailureMode(fm),
+    }
+
+    print(f"# {ttl.name}: triples={len(kgi.graph)} load_ms={load_ms:.1f} warmup_ms={warm_ms:.1f}"
+          f" skill={skill} fm={fm}")
+    for name, q in queries.items():
+        session = [ms(lambda: q(kgi)) for _ in range(reps)]
+        cold = [ms(lambda: q(KGInterface(str(ttl)))) for _ in range(cold_reps)]
+        s_med = statistics.median(session)
+        c_med = statistics.median(cold)
+        print(f"{ttl.name};{name};{c_med:.2f};{s_med:.3f};{c_med / s_med if s_med else 0.0:.0f}")
+
+
+def main():
+    reps = int(sys.argv[1]) if len(sys.argv) > 1 else 50
+    cold_reps = int(sys.argv[2]) if len(sys.argv) > 2 else 3
+    print("kg;query;cold_ms;session_ms;speedup")
+    for f in KG_FILES:
+        bench(ROOT / "src" / f, reps, cold_reps)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+// loop_latency_bench.cpp
+// Latenz post() -> Ausführung im UA-Thread für beide Main-Loop-Varianten:
+//  - "poll":    alter Loop – runIterate(50); processPosted(16) im festen Takt
+//  - "reactor": runOnce() – Warten im EventLoop des Clients, post()/postDelayed() wecken sofort
+// Tests je Modus:
+//  - "post":    einzelne post() aus einem fremden Thread (Abstand ~1 ms)
+//  - "delayed": postDelayed(5 ms), gemessen wird die Verspätung gegenüber der Deadline
+//  - "burst":   200 post() auf einmal, Zeit bis der letzte Job gelaufen ist
+//
+// Voraussetzung: tools/ua_test_server läuft.
+// Aufruf: loop_latency_bench [endpoint] [samples]   (Defaults: opc.tcp://localhost:4850, 500)
+
+#include "PLCMonitor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Stats { double p50, p99, max; };
+
+Stats stats(std::vector<double> us) {
+    if (us.empty()) return { 0.0, 0.0, 0.0 };
+    std::sort(us.begin(), us.end());
+    return { us[us.size() / 2], us[(us.size() * 99) / 100], us.back() };
+}
+
+double sinceUs(Clock::time_point t0) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+}
+
+// UA-Thread im gewählten Modus
+struct Loop {
+    PLCMonitor& mon;
+    std::atomic<bool> run{true};
+    std::thread th;
+    Loop(PLCMonitor& m, bool reactor) : mon(m) {
+        th = std::thread([this, reactor]{
+            while (run.load()) {
+                if (reactor) mon.runOnce(1000);
+                else { mon.runIterate(50); mon.processPosted(16); }
+            }
+        });
+    }
+    ~Loop() { run = false; mon.wakeup(); th.join(); }
+};
+
+// Wartet, bis done == n (Jobs laufen im UA-Thread)
+void waitFor(const std::atomic<size_t>& done, size_t n) {
+    while (done.load(std::memory_order_acquire) < n)
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+}
+
+void runMode(PLCMonitor& mon, const char* mode, bool reactor, size_t samples) {
+    Loop loop(mon, reactor);
+
+    // post: Einzelaufträge
+    {
+        std::vector<double> us(samples);
+        std::atomic<size_t> done{0};
+        for (size_t i = 0; i < samples; ++i) {
+            const auto t0 = Clock::now();
+            mon.post([&, i, t0]{ us[i] = sinceUs(t0); done.fetch_add(1, std::memory_order_release); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        waitFor(done, samples);
+        const Stats s = stats(us);
+        std::printf("%s;post;%zu;%.0f;%.0f;%.0f\n", mode, samples, s.p50, s.p99, s.max);
+    }
+    // delayed: Verspätung gegenüber der Deadline
+    {
+        const size_t n = samples / 5;
+        std::vector<double> us(n);
+        std::atomic<size_t> done{0};
+        for (size_t i = 0; i < n; ++i) {
+            const auto due = Clock::now() + std::chrono::milliseconds(5);
+            mon.postDelayed(5, [&, i, due]{ us[i] = sinceUs(due); done.fetch_add(1, std::memory_order_release); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(7));
+        }
+        waitFor(done, n);
+        const Stats s = stats(us);
+        std::printf("%s;delayed;%zu;%.0f;%.0f;%.0f\n", mode, n, s.p50, s.p99, s.max);
+    }
+    // burst: 200 Jobs auf einmal
+    {
+        constexpr size_t kBurst = 200;
+        std::vector<double> us;
+        for (size_t r = 0; r < 10; ++r) {
+            std::atomic<size_t> done{0};
+            const auto t0 = Clock::now();
+            for (size_t i = 0; i < kBurst; ++i)
+                mon.post([&]{ done.fetch_add(1, std::memory_order_release); });
+            waitFor(done, kBurst);
+            us.push_back(sinceUs(t0));
+        }
+        const Stats s = stats(us);
+        std::printf("%s;burst%zu;10;%.0f;%.0f;%.0f\n", mode, kBurst, s.p50, s.p99, s.max);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string endpoint = (argc > 1) ? argv[1] : "opc.tcp://localhost:4850";
+    const size_t samples       = (argc > 2) ? std::max<size_t>(10, std::strtoull(argv[2], nullptr, 10)) : 500;
+
+    auto opt = PLCMonitor::TestServerDefaults("certificates/client_cert.der",
+                                              "certificates/client_key.der",
+                                              endpoint);
+    PLCMonitor mon(opt);
+    if (!mon.connect() || !mon.waitUntilActivated(5000)) {
+        std::cerr << "[Bench] Verbindung zu " << endpoint << " fehlgeschlagen\n";
+        return 1;
+    }
+
+    std::printf("mode;test;n;p50_us;p99_us;max_us\n");
+    runMode(mon, "poll",    false, samples);
+    runMode(mon, "reactor", true,  samples);
+
+    mon.disconnect();
+    return 0;
+}
@@ -0,0 +1,108 @@
+// monact_bench.cpp
+// Dauer von MonitoringActionForce::filter für 1..8 Failure-Mode-Kandidaten:
+//  - "sequential": maxParallel = 1 (bisheriges Verhalten, Kandidat für Kandidat)
+//  - "parallel":   maxParallel = 4 (KG-Fetches und Methodenaufrufe gleichzeitig)
+// Jeder Kandidat hat `steps` CallMethod-Schritte auf ns=1;s=BenchObj.Echo des Test-Servers,
+// der KG-Fetch wird mit fetchMs Wartezeit simuliert (entspricht einem rdflib-Lookup).
+// Geprüft wird außerdem, dass beide Modi dieselben Kandidaten in derselben Reihenfolge liefern.
+//
+// Voraussetzung: tools/ua_test_server läuft (Methode BenchObj.Echo).
+// Aufruf: monact_bench [endpoint] [fetchMs] [steps] [reps]
+
+#include "PLCMonitor.h"
+#include "EventBus.h"
+#include "MonActionForce.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double medianMs(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+// MonAction-Payload wie aus dem KG: IRI-Header + rows, je Schritt Echo(x) mit erwartetem x
+std::string makePayload(const std::string& fm, int steps) {
+    std::string rows;
+    for (int s = 0; s < steps; ++s) {
+        const std::string st = std::to_string(s);
+        const std::string x  = std::to_string(static_cast<int>(fm.size()) * 100 + s);
+        if (!rows.empty()) rows += ",";
+        rows += R"({"step":)" + st + R"(,"g":"meta","k":"jobId","v":"BenchObj"},)"
+              + R"({"step":)" + st + R"(,"g":"method","k":"methodId","v":"BenchObj.Echo"},)"
+              + R"({"step":)" + st + R"(,"g":"input","i":0,"t":"int32","v":)" + x + "},"
+              + R"({"step":)" + st + R"(,"g":"output","i":0,"t":"int32","v":)" + x + "}";
+    }
+    return "http://example.org/monact#MA_" + fm + "\n{\"rows\":[" + rows + "]}";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string endpoint = (argc > 1) ? argv[1] : "opc.tcp://localhost:4850";
+    const int fetchMs          = (argc > 2) ? std::max(0, std::atoi(argv[2])) : 20;
+    const int steps            = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 2;
+    const int reps             = (argc > 4) ? std::max(1, std::atoi(argv[4])) : 10;
+
+    auto opt = PLCMonitor::TestServerDefaults("certificates/client_cert.der",
+                                              "certificates/client_key.der",
+                                              endpoint);
+    opt.nsIndex = 1;   // Bench-Knoten liegen in ns=1
+    PLCMonitor mon(opt);
+    if (!mon.connect() || !mon.waitUntilActivated(5000)) {
+        std::cerr << "[Bench] Verbindung zu " << endpoint << " fehlgeschlagen\n";
+        return 1;
+    }
+
+    // UA-Thread wie im Main-Loop: iterieren + gepostete Arbeit abarbeiten
+    std::atomic<bool> run{true};
+    std::thread ua([&]{
+        while (run.load()) { mon.runIterate(5); mon.processPosted(16); }
+    });
+
+    EventBus bus;
+    MonitoringActionForce::Fetcher fetch = [&](const std::string& fm) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(fetchMs));
+        return makePayload(fm, steps);
+    };
+    MonitoringActionForce seq(mon, bus, fetch, 5000, /*maxParallel=*/1);
+    MonitoringActionForce par(mon, bus, fetch, 5000, /*maxParallel=*/4);
+
+    std::cout << "candidates;sequential_ms;parallel_ms;speedup;kept;same\n";
+    for (size_t n : { 1, 2, 3, 4, 8 }) {
+        std::vector<std::string> winners;
+        for (size_t i = 0; i < n; ++i) winners.push_back("FM_" + std::string(i + 1, 'x'));
+
+        std::vector<double> s, p;
+        std::vector<std::string> keptSeq, keptPar;
+        const CorrelationId corr = makeCorrelationId(CorrSource::Other);
+        for (int r = 0; r < reps; ++r) {
+            auto t0 = Clock::now();
+            keptSeq = seq.filter(winners, corr, "BenchProcess");
+            auto t1 = Clock::now();
+            keptPar = par.filter(winners, corr, "BenchProcess");
+            auto t2 = Clock::now();
+            s.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+            p.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+            bus.process(64);   // Acks verwerfen (keine Subscriber)
+        }
+        const double ms = medianMs(s), mp = medianMs(p);
+        std::cout << n << ";" << ms << ";" << mp << ";" << (mp > 0.0 ? ms / mp : 0.0) << ";"
+                  << keptPar.size() << ";" << (keptSeq == keptPar ? "yes" : "NO") << "\n";
+    }
+
+    run = false;
+    ua.join();
+    mon.disconnect();
+    return 0;
+}
@@ -0,0 +1,76 @@
+// snapshot_read_bench.cpp
+// Misst die Lesedauer eines Snapshots in Abhängigkeit der Variablenanzahl:
+//   (a) ein synchroner Read je Variable (bisheriger Pfad in buildInventorySnapshotNow)
+//   (b) PLCMonitor::readValuesBatched (ein bzw. wenige UA_ReadRequests)
+//
+// Voraussetzung: tools/ua_test_server läuft mit "--bench-vars <max N>".
+// Aufruf: snapshot_read_bench [endpoint] [reps]
+
+#include "PLCMonitor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double medianMs(std::vector<double> v) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string endpoint = (argc > 1) ? argv[1] : "opc.tcp://localhost:4850";
+    const int reps             = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 20;
+
+    PLCMonitor mon(PLCMonitor::TestServerDefaults("certificates/client_cert.der",
+                                                  "certificates/client_key.der",
+                                                  endpoint));
+    if (!mon.connect() || !mon.waitUntilActivated(5000)) {
+        std::cerr << "[Bench] Verbindung zu " << endpoint << " fehlgeschlagen\n";
+        return 1;
+    }
+
+    const std::vector<size_t> counts = { 10, 50, 100, 200, 400, 800 };
+
+    std::cout << "N;single_ms;batched_ms;speedup\n";
+    // Schleife: je Variablenanzahl beide Lesepfade mehrfach messen (Median).
+    for (size_t n : counts) {
+        std::vector<PLCMonitor::ReadItem> items;
+        items.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            items.push_back(PLCMonitor::ReadItem{ 1, "Bench_" + std::to_string(i) });
+
+        std::vector<double> single, batched;
+        std::vector<UAValue> vals;
+        for (int r = 0; r < reps; ++r) {
+            auto t0 = Clock::now();
+            for (const auto& it : items) {
+                std::string v, t;
+                (void)mon.readAsString(it.id, it.ns, v, t);
+            }
+            auto t1 = Clock::now();
+            const bool ok = mon.readValuesBatched(items, vals);
+            auto t2 = Clock::now();
+            if (!ok) {
+                std::cerr << "[Bench] readValuesBatched fehlgeschlagen (N=" << n << ")\n";
+                return 2;
+            }
+            single.push_back (std::chrono::duration<double, std::milli>(t1 - t0).count());
+            batched.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+        }
+
+        const double s = medianMs(single), b = medianMs(batched);
+        std::cout << n << ";" << s << ";" << b << ";" << (b > 0.0 ? s / b : 0.0) << "\n";
+    }
+
+    mon.disconnect();
+    return 0;
+}
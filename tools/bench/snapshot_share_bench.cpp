@@ -0,0 +1,124 @@
+// snapshot_share_bench.cpp
+// Kosten eines D2-Snapshots entlang der Reaktionskette (ohne PLC):
+//  - "copy":   alter Pfad – Snapshot by value in der Payload, Kopie in
+//              ReactionManager::onEvent und nochmals in die Capture des Worker-Jobs
+//  - "shared": InventorySnapshotPtr – ein unveränderlicher Snapshot, alle teilen ihn
+// Gezählt werden Heap-Allokationen/-Bytes (globaler operator new) und die Zeit je Kette
+// (inkl. Freigabe des Snapshots am Ende).
+//
+// Aufruf: snapshot_share_bench [vars] [reps]   (Defaults: 1000, 200)
+
+#include "InventorySnapshot.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// Zählender globaler operator new (malloc/free sind hier gewollt gepaart)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+std::atomic<size_t> gAllocs{0};
+std::atomic<size_t> gBytes{0};
+}
+
+void* operator new(std::size_t n) {
+    gAllocs.fetch_add(1, std::memory_order_relaxed);
+    gBytes.fetch_add(n, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Inventar wie vom Test-Server: Bool/Int16/String/Double im Wechsel
+InventorySnapshot makeSnapshot(size_t vars) {
+    InventorySnapshot inv;
+    auto nodes = std::make_shared<NodeTable>();
+    auto rows  = std::make_shared<InventoryRows>();
+    for (size_t i = 0; i < vars; ++i) {
+        const std::string id = "OPCUA.BenchVar_" + std::to_string(i);
+        rows->push_back({ "Variable", "ns=4;s=" + id, "Boolean" });
+        nodes->intern(NodeKey{ 4, 's', id });
+    }
+    inv.rows = std::move(rows);
+    inv.reset(std::move(nodes));
+    for (uint32_t i = 0; i < vars; ++i) {
+        switch (i % 4) {
+            case 0: inv.setBool(i, (i & 1) != 0); break;
+            case 1: inv.setInt16(i, static_cast<int16_t>(i)); break;
+            case 2: inv.setString(i, "Skill_" + std::to_string(i)); break;
+            case 3: inv.setFloat(i, i * 0.5); break;
+        }
+    }
+    return inv;
+}
+
+struct Result { double us; size_t allocs; size_t bytes; };
+
+template <class F>
+Result measure(size_t reps, F&& hop) {
+    std::vector<double> us;
+    size_t allocs = 0, bytes = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        const size_t a0 = gAllocs.load(), b0 = gBytes.load();
+        const auto t0 = Clock::now();
+        hop();
+        us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+        allocs += gAllocs.load() - a0;
+        bytes  += gBytes.load()  - b0;
+    }
+    std::sort(us.begin(), us.end());
+    return { us[us.size() / 2], allocs / reps, bytes / reps };
+}
+
+// Alter Payload-Typ (Snapshot by value)
+struct D2SnapshotByValue {
+    std::string       correlationId;
+    InventorySnapshot inv;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t vars = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    const size_t reps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+    const InventorySnapshot proto = makeSnapshot(vars);
+    volatile size_t sink = 0;
+
+    // Pro Wiederholung: Payload aus frisch gebautem Snapshot erzeugen (Move wie in main.cpp),
+    // dann die Konsumenten der Kette. Das Bauen selbst ist in beiden Varianten gleich und
+    // wird vor der Messung erledigt.
+    std::vector<InventorySnapshot> srcCopy(reps, proto), srcShared(reps, proto);
+    size_t iCopy = 0, iShared = 0;
+    const CorrelationId corr = makeCorrelationId(CorrSource::D2);
+
+    const Result copy = measure(reps, [&]{
+        D2SnapshotByValue payload{ "evD2-1", std::move(srcCopy[iCopy++]) };
+        InventorySnapshot inRm = payload.inv;                         // onEvent: inv = p->inv
+        std::function<void()> job = [inv = inRm]{ (void)inv; };       // Capture in jobs_
+        sink = sink + job.operator bool() + inRm.slots();
+    });
+    const Result shared = measure(reps, [&]{
+        D2Snapshot payload{ corr, shareSnapshot(std::move(srcShared[iShared++])) };
+        InventorySnapshotPtr inRm = payload.inv;
+        std::function<void()> job = [snap = inRm]{ (void)snap; };
+        sink = sink + job.operator bool() + inRm->slots();
+    });
+
+    std::printf("vars;mode;us_per_chain;allocs_per_chain;bytes_per_chain\n");
+    std::printf("%zu;copy;%.1f;%zu;%zu\n",   vars, copy.us,   copy.allocs,   copy.bytes);
+    std::printf("%zu;shared;%.1f;%zu;%zu\n", vars, shared.us, shared.allocs, shared.bytes);
+    return 0;
+}
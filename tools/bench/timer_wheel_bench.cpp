@@ -0,0 +1,81 @@
+// timer_wheel_bench.cpp
+// Kosten von PLCMonitor::postDelayed/processTimers bei vielen ausstehenden Timern (ohne PLC):
+//  - "vector": alter Pfad – std::vector<TimedFn>, processTimers scannt alles und löscht
+//              fällige Einträge aus der Mitte
+//  - "wheel":  TimerWheel – O(1) Einfügen/Abbrechen, Ablauf nur über fällige Slots
+// Je Lauf: `pending` Timer mit 10 ms … 10 s Verzögerung (Pulse-Resets, Watchdogs), danach
+// ein simulierter Main-Loop mit 1 ms Ticks, in dem je Tick zwei processTimers()-Aufrufe
+// laufen (wie processPosted) und ein neuer Timer eingereiht wird.
+//
+// Aufruf: timer_wheel_bench [ticks]   (Default: 2000)
+
+#include "TimerWheel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Nachbau des früheren PLCMonitor-Timerpfads (Zeit in ms-Ticks statt time_point)
+struct VectorTimers {
+    struct TimedFn { std::uint64_t due; std::function<void()> fn; };
+    std::vector<TimedFn> timers;
+    void post(std::uint64_t due, std::function<void()> fn) { timers.push_back(TimedFn{ due, std::move(fn) }); }
+    void process(std::uint64_t now) {
+        std::vector<std::function<void()>> dueFns;
+        auto it = timers.begin();
+        while (it != timers.end()) {
+            if (it->due <= now) { dueFns.push_back(std::move(it->fn)); it = timers.erase(it); }
+            else ++it;
+        }
+        for (auto& f : dueFns) f();
+    }
+};
+
+struct WheelTimers {
+    TimerWheel wheel;
+    void post(std::uint64_t due, std::function<void()> fn) { wheel.schedule(due, std::move(fn)); }
+    void process(std::uint64_t now) {
+        std::vector<TimerWheel::Fn> dueFns;
+        wheel.advance(now, dueFns);
+        for (auto& f : dueFns) f();
+    }
+};
+
+// Deterministische Verzögerungen 10 ms … 10 s
+std::uint64_t delayOf(size_t i) { return 10 + (i * 7919) % 10000; }
+
+template <class T>
+double runUsPerTick(size_t pending, size_t ticks, size_t& fired) {
+    T t;
+    fired = 0;
+    for (size_t i = 0; i < pending; ++i) t.post(delayOf(i), [&fired]{ ++fired; });
+    const auto t0 = Clock::now();
+    for (std::uint64_t now = 1; now <= ticks; ++now) {
+        t.process(now);
+        t.post(now + delayOf(now), [&fired]{ ++fired; });
+        t.process(now);
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - t0).count() / static_cast<double>(ticks);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t ticks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+    std::printf("pending;vector_us_per_tick;wheel_us_per_tick;speedup;fired_same\n");
+    for (size_t pending : { 10, 100, 1000, 10000 }) {
+        size_t firedVec = 0, firedWheel = 0;
+        const double v = runUsPerTick<VectorTimers>(pending, ticks, firedVec);
+        const double w = runUsPerTick<WheelTimers>(pending, ticks, firedWheel);
+        std::printf("%zu;%.2f;%.2f;%.1f;%s\n", pending, v, w, w > 0.0 ? v / w : 0.0,
+                    firedVec == firedWheel ? "yes" : "NO");
+    }
+    return 0;
+}
@@ -1,5 +1,7 @@
 ﻿// ua_test_server_secure.cpp
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <open62541/plugin/log_stdout.h>
 #include <open62541/server.h>
 #include <open62541/server_config_default.h>
@@ -236,10 +238,63 @@ static void onAutomatikWrite(UA_Server *server,
     }
 }
 
+/* --------- Bench-Methode: BenchObj.Echo(Int32 x) -> Int32 x --------- */
+static UA_StatusCode benchEchoCallback(UA_Server* /*server*/,
+                                       const UA_NodeId* /*sessionId*/, void* /*sessionCtx*/,
+                                       const UA_NodeId* /*methodId*/, void* /*methodCtx*/,
+                                       const UA_NodeId* /*objectId*/, void* /*objectCtx*/,
+                                       size_t inputSize, const UA_Variant *input,
+                                       size_t outputSize, UA_Variant *output) {
+    if(inputSize < 1 || outputSize < 1 || !UA_Variant_hasScalarType(&input[0], &UA_TYPES[UA_TYPES_INT32]))
+        return UA_STATUSCODE_BADARGUMENTSMISSING;
+    return UA_Variant_setScalarCopy(&output[0], input[0].data, &UA_TYPES[UA_TYPES_INT32]);
+}
+
+static void addBenchMethod(UA_Server* server) {
+    UA_ObjectAttributes oa = UA_ObjectAttributes_default;
+    oa.displayName = UA_LOCALIZEDTEXT("en-US", const_cast<char*>("BenchObj"));
+    UA_Server_addObjectNode(server,
+        UA_NODEID_STRING(1, const_cast<char*>("BenchObj")),
+        UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER),
+        UA_NODEID_NUMERIC(0, UA_NS0ID_ORGANIZES),
+        UA_QUALIFIEDNAME(1, const_cast<char*>("BenchObj")),
+        UA_NODEID_NUMERIC(0, UA_NS0ID_BASEOBJECTTYPE),
+        oa, NULL, NULL);
+
+    UA_Argument inArg;  UA_Argument_init(&inArg);
+    inArg.name = UA_STRING(const_cast<char*>("x"));
+    inArg.dataType  = UA_TYPES[UA_TYPES_INT32].typeId;
+    inArg.valueRank = UA_VALUERANK_SCALAR;
+    UA_Argument outArg; UA_Argument_init(&outArg);
+    outArg.name = UA_STRING(const_cast<char*>("y"));
+    outArg.dataType  = UA_TYPES[UA_TYPES_INT32].typeId;
+    outArg.valueRank = UA_VALUERANK_SCALAR;
+
+    UA_MethodAttributes ma = UA_MethodAttributes_default;
+    ma.displayName    = UA_LOCALIZEDTEXT("en-US", const_cast<char*>("Echo"));
+    ma.executable     = true;
+    ma.userExecutable = true;
+    UA_Server_addMethodNode(server,
+        UA_NODEID_STRING(1, const_cast<char*>("BenchObj.Echo")),
+        UA_NODEID_STRING(1, const_cast<char*>("BenchObj")),
+        UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT),
+        UA_QUALIFIEDNAME(1, const_cast<char*>("Echo")),
+        ma, &benchEchoCallback, 1, &inArg, 1, &outArg, NULL, NULL);
+}
+
 /* --------- main --------- */
-int main() {
+/* Optional: "--bench-vars N" legt N zusaetzliche Variablen ns=1;s=Bench_<i> an
+   (abwechselnd Boolean/Int32/String) – fuer tools/bench/snapshot_read_bench.
+   Immer vorhanden: Methode ns=1;s=BenchObj.Echo(Int32) – fuer tools/bench/monact_bench. */
+int main(int argc, char** argv) {
     UA_StatusCode ret = UA_STATUSCODE_GOOD;
 
+    int benchVars = 0;
+    for(int i = 1; i + 1 < argc; ++i) {
+        if(std::strcmp(argv[i], "--bench-vars") == 0)
+            benchVars = std::atoi(argv[i + 1]);
+    }
+
     /* Server und Default-Konfiguration */
     UA_Server *server = UA_Server_new();
     UA_ServerConfig *config = UA_Server_getConfig(server);
@@ -318,6 +373,25 @@ int main() {
     addBool("Automatikbetrieb",  UA_TRUE,  gAutomatikbetriebId);
     addInt ("z1",                0,        gZ1Id);
 
+    /* Benchmark-Variablen (nur mit --bench-vars) */
+    for(int i = 0; i < benchVars; ++i) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "Bench_%d", i);
+        UA_NodeId id = UA_NODEID_NULL;
+        switch(i % 3) {
+            case 0:  addBool(name, (i & 1) ? UA_TRUE : UA_FALSE, id); break;
+            case 1:  addInt (name, (UA_Int32)i,                 id); break;
+            default: addStr (name, name,                         id); break;
+        }
+        UA_NodeId_clear(&id);
+    }
+    if(benchVars > 0)
+        UA_LOG_INFO(UA_Log_Stdout, UA_LOGCATEGORY_SERVER,
+                    "[Server] %d Bench-Variablen angelegt (ns=1;s=Bench_<i>)", benchVars);
+
+    /* Bench-Methode (fuer tools/bench/monact_bench) */
+    addBenchMethod(server);
+
     /* Write-Callback auf DiagnoseFinished (void-Signatur in deiner Version) */
     {
         UA_ValueCallback cb; cb.onRead = nullptr; cb.onWrite = onDiagnoseFinishedWrite;